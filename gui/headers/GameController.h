@@ -2,6 +2,7 @@
 #define GAMECONTROLLER_H
 
 #include <QObject>
+#include <thread>
 #include "Model.h"
 #include "PlayerType.h"
 
@@ -12,6 +13,7 @@ public:
                             PlayerType* xPlayer,
                             PlayerType* oPlayer,
                             QObject* parent = nullptr);
+    ~GameController();
 
 public slots:
     void handleHumanMove(int row, int col);
@@ -27,10 +29,19 @@ signals:
 
 private:
     void playAIMove();
+    void finishAIMove(int cell, int generation);  // Apply the move found by the worker thread
+    void cancelAIMove();  // Abort the AI move in flight and wait for its worker
+    void startPondering();  // Let the AI search its replies during the human's turn
+    int aiMoveDelay() const;  // Milliseconds before the next AI move, none when its reply is pondered
 
     Model* m_model;
     PlayerType* m_xPlayer;
     PlayerType* m_oPlayer;
+
+    std::thread m_aiThread;  // Searches the AI move away from the UI thread
+    CancelToken m_aiCancel;  // Cancels the search of m_aiThread
+    int m_aiGeneration;  // Changes on every AI move and reset so stale results are dropped
+    bool m_aiThinking;  // True while an AI move is searched
 };
 
 #endif // GAMECONTROLLER_H
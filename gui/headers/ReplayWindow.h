@@ -5,6 +5,7 @@
 #include <QTimer>
 #include <QPushButton>
 #include "PlayerType.h"
+#include "Model.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class ReplayWindow; }
@@ -25,13 +26,13 @@ private slots:
 
 private:
     Ui::ReplayWindow *ui;
-    QVector<Move> moves;
-    int moveIndex;
+    Model replay;  // Holds the recorded moves as undone moves that are redone one by one
     QTimer* timer;
 
     QPushButton* cellButtons[3][3];
     void setupGrid();
     void simulateMove(int row, int col, const QString& symbol);
+    bool showNextMove();
 };
 
 #endif // REPLAYWINDOW_H
@@ -1,4 +1,5 @@
 #include "GameController.h"
+#include <QMetaObject>
 #include <QTimer>
 #include "exceptions.h"
 
@@ -6,10 +7,57 @@ GameController::GameController(Model* model,
                                PlayerType* xPlayer,
                                PlayerType* oPlayer,
                                QObject* parent)
-    : QObject(parent), m_model(model), m_xPlayer(xPlayer), m_oPlayer(oPlayer)
+    : QObject(parent), m_model(model), m_xPlayer(xPlayer), m_oPlayer(oPlayer),
+      m_aiGeneration(0), m_aiThinking(false)
 {}
 
+GameController::~GameController() {
+    cancelAIMove();
+    if (!m_xPlayer->isHuman()) static_cast<AI*>(m_xPlayer)->stopPondering();
+    if (!m_oPlayer->isHuman()) static_cast<AI*>(m_oPlayer)->stopPondering();
+}
+
+void GameController::cancelAIMove() {
+    // The search sees the token at its next check, so the join is immediate
+    m_aiCancel.cancel();
+    m_aiGeneration++;
+    m_aiThinking = false;
+
+    if (m_aiThread.joinable()) {
+        m_aiThread.join();
+    }
+}
+
+void GameController::startPondering() {
+    if (m_model->isTheGameOver()) return;
+
+    // The player waiting for the human's move is the one that ponders
+    Player current = m_model->whoIsNext();
+    PlayerType* waiting = (current == X) ? m_oPlayer : m_xPlayer;
+    PlayerType* thinking = (current == X) ? m_xPlayer : m_oPlayer;
+
+    if (thinking->isHuman() && !waiting->isHuman()) {
+        static_cast<AI*>(waiting)->ponder(*m_model);
+    }
+}
+
+int GameController::aiMoveDelay() const {
+    // A pondered reply is played at once, a searched one is paced so the human sees the board change
+    Player current = m_model->whoIsNext();
+    PlayerType* player = (current == X) ? m_xPlayer : m_oPlayer;
+
+    if (!player->isHuman() && static_cast<AI*>(player)->hasPonderedReply(*m_model)) {
+        return 0;
+    }
+    return 300;
+}
+
 void GameController::resetGame() {
+    // The move in flight and the pondered replies belong to the old game
+    cancelAIMove();
+    if (!m_xPlayer->isHuman()) static_cast<AI*>(m_xPlayer)->stopPondering();
+    if (!m_oPlayer->isHuman()) static_cast<AI*>(m_oPlayer)->stopPondering();
+
     *m_model = Model();
     emit boardChanged();
     emit currentPlayerChanged(m_model->whoIsNext());
@@ -17,7 +65,9 @@ void GameController::resetGame() {
     // If AI goes first, trigger with delay
     if ((m_model->whoIsNext() == X && !m_xPlayer->isHuman()) ||
         (m_model->whoIsNext() == O && !m_oPlayer->isHuman())) {
-        QTimer::singleShot(300, this, &GameController::triggerAIMove);
+        QTimer::singleShot(aiMoveDelay(), this, &GameController::triggerAIMove);
+    } else {
+        startPondering();
     }
 }
 
@@ -50,7 +100,7 @@ void GameController::handleHumanMove(int row, int col) {
             // Trigger AI move with delay if needed
             if ((m_model->whoIsNext() == X && !m_xPlayer->isHuman()) ||
                 (m_model->whoIsNext() == O && !m_oPlayer->isHuman())) {
-                QTimer::singleShot(300, this, &GameController::triggerAIMove);
+                QTimer::singleShot(aiMoveDelay(), this, &GameController::triggerAIMove);
             }
         }
 
@@ -66,43 +116,56 @@ void GameController::triggerAIMove() {
 }
 
 void GameController::playAIMove() {
-    if (m_model->isTheGameOver()) return;
+    if (m_model->isTheGameOver() || m_aiThinking) return;
 
-    try {
-        Player current = m_model->whoIsNext();
+    Player current = m_model->whoIsNext();
+    PlayerType* player = (current == X) ? m_xPlayer : m_oPlayer;
+    if (player->isHuman()) return;
 
-        // Save grid state BEFORE AI move
-        auto grid_before = m_model->getGrid();
-        int aiRow = -1, aiCol = -1;
+    // The worker searches a copy of the model, the UI thread keeps the real one
+    if (m_aiThread.joinable()) {
+        m_aiThread.join();
+    }
 
-        if (current == X && !m_xPlayer->isHuman()) {
-            m_xPlayer->play(X, *m_model, -1, -1);
-        }
-        else if (current == O && !m_oPlayer->isHuman()) {
-            m_oPlayer->play(O, *m_model, -1, -1);
-        }
-        else {
-            return;
+    AI* ai = static_cast<AI*>(player);
+    Model snapshot = *m_model;
+    CancelToken token;
+    int generation = ++m_aiGeneration;
+
+    m_aiCancel = token;
+    m_aiThinking = true;
+    m_aiThread = std::thread([this, ai, snapshot, token, generation]() {
+        int cell = -1;
+        try {
+            cell = ai->chooseMove(snapshot, token);
+        } catch (const std::exception&) {
+            cell = -1;
         }
 
-        // Get grid AFTER AI move
-        auto grid_after = m_model->getGrid();
-
-        // Find the changed cell
-        for (int r = 0; r < 3; r++) {
-            for (int c = 0; c < 3; c++) {
-                if (grid_before[r][c] == Open && grid_after[r][c] != Open) {
-                    aiRow = r;
-                    aiCol = c;
-                    break; // Found the move
-                }
-            }
-            if (aiRow != -1) break; // Exit early if found
-        }
+        // Deliver the result on the UI thread
+        QMetaObject::invokeMethod(this, [this, cell, generation]() {
+            finishAIMove(cell, generation);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void GameController::finishAIMove(int cell, int generation) {
+    // A reset or a newer move made this result stale
+    if (generation != m_aiGeneration) return;
+
+    m_aiThinking = false;
+    if (m_aiThread.joinable()) {
+        m_aiThread.join();
+    }
+    if (cell < 0 || m_model->isTheGameOver()) return;
+
+    try {
+        m_model->play(cell / Model::BoardType::COLS, cell % Model::BoardType::COLS);
 
-        // Signal AI move
-        if (aiRow != -1 && aiCol != -1) {
-            emit moveMade(aiRow, aiCol);
+        // Signal AI move, the model remembers the move the AI played
+        Move aiMove = m_model->lastMove();
+        if (aiMove.row != -1 && aiMove.column != -1) {
+            emit moveMade(aiMove.row, aiMove.column);
         }
 
         m_model->updateStatus();
@@ -112,10 +175,12 @@ void GameController::playAIMove() {
             emit gameEnded(m_model->getStatus());
         } else {
             emit currentPlayerChanged(m_model->whoIsNext());
-            // Continue AI chain if needed
+            // Continue AI chain if needed, otherwise think on the human's time
             if ((m_model->whoIsNext() == X && !m_xPlayer->isHuman()) ||
                 (m_model->whoIsNext() == O && !m_oPlayer->isHuman())) {
-                QTimer::singleShot(300, this, &GameController::triggerAIMove);
+                QTimer::singleShot(aiMoveDelay(), this, &GameController::triggerAIMove);
+            } else {
+                startPondering();
             }
         }
 
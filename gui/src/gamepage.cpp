@@ -1,6 +1,7 @@
 #include "gamepage.h"
 #include "ui_gamepage.h"
 #include "GameController.h"
+#include <QRandomGenerator>
 #include <QTimer>
 #include <QVBoxLayout>
 #include <QMenuBar>
@@ -26,8 +27,14 @@ GamePage::GamePage(QWidget *parent,
 
     // Create players
     xPlayer = new Human();
-    oPlayer = isAI ? static_cast<PlayerType*>(new AI(aiLevel))
-                   : static_cast<PlayerType*>(new Human());
+    if (isAI) {
+        AI* ai = new AI(aiLevel);
+        ai->setTimeLimit(250);  // Keep every AI move under a quarter of a second
+        ai->setSeed(QRandomGenerator::global()->generate64());  // A new game every time
+        oPlayer = ai;
+    } else {
+        oPlayer = new Human();
+    }
 
     // Find cell buttons
     for (int i = 0; i < 3; ++i)
@@ -75,9 +82,10 @@ GamePage::GamePage(QWidget *parent,
 }
 
 GamePage::~GamePage() {
+    // The controller stops the AI threads before the players go away
+    delete controller;
     delete xPlayer;
     delete oPlayer;
-    delete controller;
     delete ui;
 }
 
@@ -2,9 +2,16 @@
 #include "ui_replaywindow.h"
 
 ReplayWindow::ReplayWindow(const QVector<Move>& moves, QWidget *parent)
-    : QWidget(parent), ui(new Ui::ReplayWindow), moves(moves), moveIndex(0)
+    : QWidget(parent), ui(new Ui::ReplayWindow)
 {
     ui->setupUi(this);
+
+    // Load the game and rewind it, every step of the replay is a redo
+    for (const Move& move : moves) {
+        if (replay.tryPlay(move.row, move.column) != Played) break;
+    }
+    while (replay.undo()) {}
+
     setWindowTitle("Replay Game");
     setupGrid();
 
@@ -37,27 +44,25 @@ void ReplayWindow::simulateMove(int row, int col, const QString& symbol) {
     }
 }
 
+bool ReplayWindow::showNextMove() {
+    if (!replay.redo()) return false;
+
+    Move move = replay.lastMove();
+    simulateMove(move.row, move.column, replay.getCell(move.row, move.column) == XCell ? "X" : "O");
+    return true;
+}
+
 void ReplayWindow::on_nextMoveButton_clicked() {
-    if (moveIndex < moves.size()) {
-        const Move& move = moves[moveIndex];
-        QString symbol = (moveIndex % 2 == 0) ? "X" : "O";
-        simulateMove(move.row, move.column, symbol);
-        moveIndex++;
-    }
+    showNextMove();
 
-    if (moveIndex >= moves.size()) {
+    if (!replay.canRedo()) {
         ui->nextMoveButton->setEnabled(false);
         ui->playAllButton->setEnabled(false);
     }
 }
 
 void ReplayWindow::playNextMove() {
-    if (moveIndex < moves.size()) {
-        const Move& move = moves[moveIndex];
-        QString symbol = (moveIndex % 2 == 0) ? "X" : "O";
-        simulateMove(move.row, move.column, symbol);
-        moveIndex++;
-    } else {
+    if (!showNextMove()) {
         timer->stop();
         ui->nextMoveButton->setEnabled(false);
         ui->playAllButton->setEnabled(false);
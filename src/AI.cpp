@@ -1,209 +1,514 @@
 #include "PlayerType.h"
 #include "Model.h"
+#include "Symmetry.h"
+#include "MoveGen.h"
+#include "SolvedTable.h"
+#include "Search.h"
+#include "ParallelSearch.h"
+#include "Mcts.h"
+#include "BatchEvaluator.h"
+#include "Threats.h"
+#include "OpeningBook.h"
+#include "ProofSearch.h"
+#include <chrono>
 #include <iostream>
-#include <array>
-#include <vector>
-#include <limits> 
 using namespace std;
 
-void AI::playBestMove(Model& game, Player aiPlayer) {
-    // initializing variables
-    int bestScore = numeric_limits<int>::min();
-    int bestRow = -1;
-    int bestCol = -1;
-    array<array<Cell, 3>, 3> grid = game.getGrid();
-
-    // try all moves
-    for (int row = 0; row < 3; row++) {
-        for (int col = 0; col < 3; col++) {
-            // try a move
-            if (grid[row][col] == Open) {
-                game.play(row, col);
-                game.updateStatus();
-
-                int score = minimax(game, 0, false, numeric_limits<int>::min(), numeric_limits<int>::max(), aiPlayer);
-
-                game.undo(row, col);
-
-                // update the best score
-                if (score > bestScore) {
-                    bestScore = score;
-                    bestRow = row;
-                    bestCol = col;
-                }
-            }
-        }
+template <typename GameBoard>
+ThreadPool& BasicAI<GameBoard>::getPool() {
+    // the pool is started on its first use and again when the number of threads changes
+    if (!pool || pool->size() != threads) {
+        pool.reset(new ThreadPool(threads));
     }
 
-    // play the best move
-    game.play(bestRow, bestCol);
-    game.updateStatus();
+    return *pool;
 }
 
-int AI::minimax(Model& game, int depth, bool maximizingPlayer, int alpha, int beta, Player player) {
-    // check if the game is over and if it's over who won if any
-    if (game.isTheGameOver()) {
-        if (game.getStatus() == Win) {
-            return (player == game.getWinner()) ? 10 - depth : depth - 10;
-        }
-        else if (game.getStatus() == Draw) {
-            return 0;
+template <typename GameBoard>
+bool BasicAI<GameBoard>::playSolvedMove(Model& game) {
+    // only the 3x3 game is solved
+    if constexpr (is_same<GameBoard, Board<3, 3, 3>>::value) {
+        // the solved table is indexed by the base-3 index of the position
+        const SolvedEntry& entry = SOLVED_TABLE[static_cast<uint32_t>(game.encode())];
+
+        if (entry.bestCell >= 0) {
+            game.playUnchecked(entry.bestCell);
+            return true;
         }
     }
 
-    // initializing variables
-    int bestScore = maximizingPlayer ? numeric_limits<int>::min() : numeric_limits<int>::max();
-    array<array<Cell, 3>, 3> grid = game.getGrid();
-
-    // explore all possible moves
-    for (int row = 0; row < 3; row++) {
-        for (int col = 0; col < 3; col++) {
-            if (grid[row][col] == Open) {
-                // try a move
-                game.play(row, col);
-                game.updateStatus();
-                int score = minimax(game, depth + 1, !maximizingPlayer, alpha, beta, player);
-                game.undo(row, col);
-
-                // update teh best score
-                if (maximizingPlayer) {
-                    bestScore = max(bestScore, score);
-                    alpha = max(alpha, bestScore);
-                }
-                else {
-                    bestScore = min(bestScore, score);
-                    beta = min(beta, bestScore);
-                }
-
-                // purning
-                if (beta <= alpha) {
-                    break;
-                }
-            }
-        }
+    return false;
+}
+
+template <typename GameBoard>
+bool BasicAI<GameBoard>::playBookMove(Model& game) {
+    int cell = book ? book->bestCell(game.getBoard()) : -1;
+
+    if (cell < 0 || !(game.getBoard().empty() & GameBoard::bit(cell))) {
+        return false;
     }
 
-    return bestScore;
+    game.playUnchecked(cell);
+    return true;
 }
 
-void AI::playEasyMove(Model& game) {
-    // initializing variables
-    array<array<Cell, 3>, 3> grid = game.getGrid();
-    vector<Move> availableMoves;
+template <typename GameBoard>
+int64_t BasicAI<GameBoard>::remainingTime() const {
+    if (timeLimit <= 0) {
+        return 0;
+    }
 
-    // get all open cells
-    for (int row = 0; row < 3; row++) {
-        for (int col = 0; col < 3; col++) {
-            if (grid[row][col] == Open) {
-                Move move;
-                move.row = row;
-                move.column = col;
-                availableMoves.emplace_back(move);
-            }
-        }
+    int64_t elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - moveStart).count();
+    return max<int64_t>(timeLimit - elapsed, 1);
+}
+
+template <typename GameBoard>
+bool BasicAI<GameBoard>::playProvenMove(Model& game) {
+    if (proofNodes == 0) {
+        return false;
+    }
+    if (!solver) {
+        solver.reset(new ProofSearch<GameBoard>(1));
     }
 
-    // play the move
-    if (!availableMoves.empty()) {
-        int idx = rand() % availableMoves.size();
-        game.play(availableMoves[idx].row, availableMoves[idx].column);
-        game.updateStatus();
+    // the search after a failed proof gets the rest of the time
+    SearchLimits limits;
+    limits.nodes = proofNodes;
+    limits.milliseconds = (timeLimit > 0) ? max<int64_t>(remainingTime() / 2, 1) : 0;
+    solver->setStopFlag(cancelFlag);
+
+    // a proven loss is left to the search, it knows which move loses the slowest
+    typename ProofSearch<GameBoard>::Result result = solver->solve(game.getBoard(), limits);
+    lastStats.nodes += result.nodes;
+    if ((result.result != ProvenWin && result.result != ProvenDraw) || result.cell < 0) {
+        return false;
     }
+
+    game.playUnchecked(result.cell);
+    return true;
 }
 
-void AI::playNormalMove(Model& game, Player aiPlayer) {
-    // initializing variables
-    array<array<Cell, 3>, 3> grid = game.getGrid();
-    Cell opponentCell = (aiPlayer == X) ? OCell : XCell;
+template <typename GameBoard>
+int BasicAI<GameBoard>::searchBestCell(const GameBoard& board, const atomic<bool>* stop) {
+    GameBoard copy = board;
+    Search<GameBoard> search(table);
+    search.setStopFlag(stop);
 
-    // check if there is an imidiate win
-    for (int row = 0; row < 3; row++) {
-        for (int col = 0; col < 3; col++) {
-            if (grid[row][col] == Open) {
-                game.play(row, col);
-                game.updateStatus();
-
-                if (game.getStatus() == Win && game.getWinner() == aiPlayer) {
-                    return;
-                }
-                
-                game.undo(row, col);
+    SearchLimits limits;
+    limits.milliseconds = timeLimit;
+    limits.nodes = nodeLimit;
+
+    typename Search<GameBoard>::Result best = search.iterativeDeepening(
+        copy, GameBoard::CELLS - copy.moveCount(), Symmetry<GameBoard>::uniqueMoves(copy), limits);
+
+    // a search cut by the flag is shallower than the one the move would get
+    if (stop != nullptr && stop->load() && search.wasStopped()) {
+        return -1;
+    }
+
+    return best.cell;
+}
+
+template <typename GameBoard>
+void BasicAI<GameBoard>::ponderReplies(const GameBoard& board) {
+    // the move the table expects from the opponent is searched first
+    MoveList<GameBoard::CELLS> moves(board.empty());
+    TTEntry entry;
+    if (table.probe(board.hash(), entry)) {
+        for (int& cell : moves) {
+            if (cell == entry.bestMove) {
+                swap(cell, moves[0]);
             }
         }
     }
 
-    // check if there is a block
-    for (int row = 0; row < 3; row++) {
-        for (int col = 0; col < 3; col++) {
-            if (grid[row][col] == Open) {
-                grid[row][col] = opponentCell;
-
-                if (isOpponentWin(grid, opponentCell)) {
-                    game.play(row, col);
-                    game.updateStatus();
-                    return;
-                }
-                else {
-                    grid[row][col] = Open;
-                }
-            }
+    for (int cell : moves) {
+        if (ponderStop) {
+            break;
+        }
+
+        GameBoard reply = board;
+        reply.place(cell, reply.sideToMove());
+        if (reply.isWinAt(cell, board.sideToMove()) || reply.isFull()) {
+            continue;
+        }
+
+        // the book answers its positions without searching
+        if (book && book->bestCell(reply) >= 0) {
+            continue;
+        }
+
+        int best = searchBestCell(reply, &ponderStop);
+        if (best >= 0) {
+            lock_guard<mutex> lock(ponderMutex);
+            ponderedReplies[reply.hash()] = best;
         }
     }
 
-    // play a random move
-    playEasyMove(game);
+    pondering = false;
 }
 
-bool AI::isOpponentWin(array<array<Cell, 3>, 3> grid, Cell winner) {
-    // check the win through rows and columns
-    for (int i = 0; i < 3; i++) {
-        // check if it's a row win
-        if (grid[i][0] == winner && grid[i][1] == winner && grid[i][2] == winner) {
-            return true;
-        }
-        // check if it's a column win
-        else if (grid[0][i] == winner && grid[1][i] == winner && grid[2][i] == winner) {
-            return true;
+template <typename GameBoard>
+void BasicAI<GameBoard>::playBestMove(Model& game) {
+    // the reply may already be known from the opponent's time
+    {
+        lock_guard<mutex> lock(ponderMutex);
+        auto pondered = ponderedReplies.find(game.hash());
+        bool found = pondered != ponderedReplies.end();
+        int cell = found ? pondered->second : -1;
+        ponderedReplies.clear();
+
+        if (found && (game.getBoard().empty() & GameBoard::bit(cell))) {
+            ponderHits++;
+            game.playUnchecked(cell);
+            return;
         }
     }
 
-    // check if it's a diagonal win
-    if (grid[0][0] == winner && grid[1][1] == winner && grid[2][2] == winner) {
-        return true;
+    // the entries of the older moves stay but can be replaced first
+    table.newSearch();
+
+    GameBoard board = game.getBoard();
+
+    SearchLimits limits;
+    limits.milliseconds = remainingTime();
+    limits.nodes = nodeLimit;
+
+    // symmetric moves have the same score so only the first of every group is searched
+    int maxDepth = GameBoard::CELLS - board.moveCount();
+    typename GameBoard::Mask rootMoves = Symmetry<GameBoard>::uniqueMoves(board);
+    typename Search<GameBoard>::Result best;
+    SearchCounters counters;
+
+    if (threads > 1) {
+        ParallelSearch<GameBoard> search(table, getPool());
+        search.setStopFlag(cancelFlag);
+        best = search.iterativeDeepening(board, maxDepth, rootMoves, limits);
+        counters = search.getCounters();
     }
-    else if (grid[0][2] == winner && grid[1][1] == winner && grid[2][0] == winner) {
-        return true;
+    else {
+        Search<GameBoard> search(table);
+        search.setStopFlag(cancelFlag);
+        best = search.iterativeDeepening(board, maxDepth, rootMoves, limits);
+        counters = search.getCounters();
     }
 
-    return false;
+    lastStats.nodes += counters.nodes;
+    lastStats.cutoffs += counters.cutoffs;
+    lastStats.maxDepth = max(lastStats.maxDepth, counters.maxPly);
+    lastStats.tableHits += counters.tableHits;
+    lastStats.tableStores += counters.tableStores;
+
+    // play the best move
+    game.playUnchecked(best.cell);
 }
 
-AI::AI(Difficulty diff) {
+template <typename GameBoard>
+void BasicAI<GameBoard>::playMonteCarloMove(Model& game) {
+    // the tree is allocated once and follows the game, its playouts are played in bit-sliced batches
+    if (!mcts) {
+        mcts.reset(new Mcts<GameBoard>(Mcts<GameBoard>::DEFAULT_CAPACITY, seed));
+        mcts->setBatchSize(Mcts<GameBoard>::AI_BATCH_SIZE);
+    }
+
+    SearchLimits limits;
+    limits.milliseconds = remainingTime();
+    limits.nodes = nodeLimit;
+
+    mcts->setStopFlag(cancelFlag);
+    typename Mcts<GameBoard>::Result best = mcts->search(game.getBoard(), limits);
+    lastStats.nodes += mcts->getPlayouts();
+
+    // play the best move
+    game.playUnchecked(best.cell);
+}
+
+template <typename GameBoard>
+void BasicAI<GameBoard>::playEasyMove(Model& game) {
+    // the open cells, a random one of them is picked by its bit index
+    typename GameBoard::Mask open = game.getBoard().empty();
+
+    // play the move
+    if (open) {
+        game.playUnchecked(nthBit(open, random.below(popCount(open))));
+    }
+}
+
+template <typename GameBoard>
+void BasicAI<GameBoard>::playNormalMove(Model& game, Player aiPlayer) {
+    // the threat table gives the cells that complete a line
+    const GameBoard& board = game.getBoard();
+    typename GameBoard::Mask wins = Threats<GameBoard>::winningMoves(board, aiPlayer);
+    typename GameBoard::Mask blocks = Threats<GameBoard>::blockingMoves(board, aiPlayer);
+
+    // check if there is an imidiate win
+    if (wins) {
+        game.playUnchecked(lowestBit(wins));
+    }
+    // check if there is a block
+    else if (blocks) {
+        game.playUnchecked(lowestBit(blocks));
+    }
+    // play a random move
+    else {
+        playEasyMove(game);
+    }
+}
+
+template <typename GameBoard>
+BasicAI<GameBoard>::BasicAI(Difficulty diff) {
     difficulty = diff;
+    useSolvedTable = true;
+    timeLimit = 0;
+    nodeLimit = 0;
+    threads = 1;
+    seed = 0;
+    random.seed(seed);
+    ponderStop = false;
+    pondering = false;
+    ponderHits = 0;
+    cancelFlag = nullptr;
+    proofNodes = 0;
+}
+
+template <typename GameBoard>
+BasicAI<GameBoard>::~BasicAI() {
+    stopPondering();
 }
 
-void AI::play(Player player, Model& game, int row, int col) {
+template <typename GameBoard>
+void BasicAI<GameBoard>::play(Player player, Model& game, int row, int col) {
+    // the pondering thread shares the table with the search below
+    stopPondering();
+
+    // the only checked call, the search below uses the unchecked model api
+    if (game.isTheGameOver()) {
+        throw IllegalStateException();
+    }
+
+    // the stats of the move
+    lastStats = SearchStats();
+    lastStats.moves = 1;
+    moveStart = chrono::steady_clock::now();
+
     // identify how to play for every difficulty
     switch (difficulty) {
         case Easy:
             playEasyMove(game);
             break;
         case Normal:
-            playNormalMove(game, game.whoIsNext());
+            playNormalMove(game, game.sideToMove());
             break;
         case Hard:
-            playBestMove(game, game.whoIsNext());
+            // search only if the table is off or doesn't know the position, the book doesn't either and the
+            // solver can't prove a move
+            if ((!useSolvedTable || !playSolvedMove(game)) && !playBookMove(game) && !playProvenMove(game)) {
+                playBestMove(game);
+            }
+            break;
+        case MonteCarlo:
+            if (!playBookMove(game)) {
+                playMonteCarloMove(game);
+            }
             break;
         default:
-            playNormalMove(game, game.whoIsNext());
+            playNormalMove(game, game.sideToMove());
             break;
     }
+
+    lastStats.seconds = chrono::duration<double>(chrono::steady_clock::now() - moveStart).count();
+    totalStats.add(lastStats);
 }
 
-bool AI::isHuman() {
+template <typename GameBoard>
+bool BasicAI<GameBoard>::isHuman() {
     return false;
 }
 
-Difficulty AI::getDifficulty() {
+template <typename GameBoard>
+Difficulty BasicAI<GameBoard>::getDifficulty() {
     return difficulty;
-}
\ No newline at end of file
+}
+
+template <typename GameBoard>
+void BasicAI<GameBoard>::setUseSolvedTable(bool use) {
+    useSolvedTable = use;
+}
+
+template <typename GameBoard>
+void BasicAI<GameBoard>::setTableSize(size_t megabytes) {
+    table.resize(megabytes);
+}
+
+template <typename GameBoard>
+void BasicAI<GameBoard>::setTimeLimit(int64_t milliseconds) {
+    timeLimit = milliseconds;
+}
+
+template <typename GameBoard>
+void BasicAI<GameBoard>::setNodeLimit(uint64_t nodes) {
+    nodeLimit = nodes;
+}
+
+template <typename GameBoard>
+void BasicAI<GameBoard>::setThreads(int count) {
+    threads = max(count, 1);
+}
+
+template <typename GameBoard>
+int BasicAI<GameBoard>::getThreads() const {
+    return threads;
+}
+
+template <typename GameBoard>
+int BasicAI<GameBoard>::chooseMove(const Model& game, const CancelToken& token) {
+    Model copy = game;
+
+    cancelFlag = token.get();
+    try {
+        play(copy.sideToMove(), copy, -1, -1);
+    }
+    catch (...) {
+        cancelFlag = nullptr;
+        throw;
+    }
+    cancelFlag = nullptr;
+
+    if (token.isCancelled()) {
+        return -1;
+    }
+
+    Move move = copy.lastMove();
+    return GameBoard::index(move.row, move.column);
+}
+
+template <typename GameBoard>
+void BasicAI<GameBoard>::ponder(const Model& game) {
+    stopPondering();
+
+    // only the hard ai takes time to find its moves, and not on 3x3 where the solved table answers every position
+    Model position = game;
+    if (difficulty != Hard || (useSolvedTable && is_same<GameBoard, Board<3, 3, 3>>::value) ||
+        position.isTheGameOver()) {
+        return;
+    }
+
+    table.newSearch();
+    ponderStop = false;
+    pondering = true;
+    ponderThread = thread(&BasicAI::ponderReplies, this, position.getBoard());
+}
+
+template <typename GameBoard>
+void BasicAI<GameBoard>::stopPondering() {
+    ponderStop = true;
+
+    if (ponderThread.joinable()) {
+        ponderThread.join();
+    }
+
+    pondering = false;
+}
+
+template <typename GameBoard>
+bool BasicAI<GameBoard>::isPondering() const {
+    return pondering;
+}
+
+template <typename GameBoard>
+uint64_t BasicAI<GameBoard>::getPonderHits() const {
+    return ponderHits;
+}
+
+template <typename GameBoard>
+bool BasicAI<GameBoard>::hasPonderedReply(const Model& game) const {
+    lock_guard<mutex> lock(ponderMutex);
+    return ponderedReplies.count(game.hash()) != 0;
+}
+
+template <typename GameBoard>
+bool BasicAI<GameBoard>::loadOpeningBook(const string& path) {
+    // the pondering thread reads the book
+    stopPondering();
+    book.reset(new OpeningBook());
+
+    // a book of another board size would never know a position of the game
+    if (!book->open(path) ||
+        !book->matches(GameBoard::ROWS, GameBoard::COLS, GameBoard::WIN_LENGTH)) {
+        book.reset();
+        return false;
+    }
+
+    return true;
+}
+
+template <typename GameBoard>
+void BasicAI<GameBoard>::setProofNodeLimit(uint64_t nodes) {
+    proofNodes = nodes;
+}
+
+template <typename GameBoard>
+void BasicAI<GameBoard>::setSeed(uint64_t value) {
+    seed = value;
+    random.seed(seed);
+
+    if (mcts) {
+        mcts->setSeed(seed);
+    }
+}
+
+template <typename GameBoard>
+uint64_t BasicAI<GameBoard>::getSeed() const {
+    return seed;
+}
+
+template <typename GameBoard>
+template <typename B>
+vector<Evaluation> BasicAI<GameBoard>::evaluate(const vector<typename Encoding<B>::Packed>& positions) {
+    // the pondering thread shares the table
+    stopPondering();
+
+    SearchLimits limits;
+    limits.milliseconds = timeLimit;
+    limits.nodes = nodeLimit;
+
+    BatchEvaluator<B> evaluator(table, (threads > 1) ? &getPool() : nullptr, limits);
+    evaluator.setUseSolvedTable(useSolvedTable);
+
+    return evaluator.evaluate(positions);
+}
+
+template <typename GameBoard>
+const SearchStats& BasicAI<GameBoard>::getLastStats() const {
+    return lastStats;
+}
+
+template <typename GameBoard>
+const SearchStats& BasicAI<GameBoard>::getTotalStats() const {
+    return totalStats;
+}
+
+template <typename GameBoard>
+void BasicAI<GameBoard>::resetStats() {
+    totalStats = SearchStats();
+}
+
+template <typename GameBoard>
+double BasicAI<GameBoard>::getPlayoutsPerSecond() const {
+    return mcts ? mcts->getPlayoutsPerSecond() : 0.0;
+}
+
+template <typename GameBoard>
+const TranspositionTable& BasicAI<GameBoard>::getTranspositionTable() const {
+    return table;
+}
+
+// the boards of withBoardSize, the ones of at most 32 cells can evaluate packed positions
+template class BasicAI<Board<3, 3, 3>>;
+template class BasicAI<Board<4, 4, 4>>;
+template class BasicAI<Board<5, 5, 4>>;
+template class BasicAI<Board<6, 6, 4>>;
+template class BasicAI<Board<7, 7, 5>>;
+template vector<Evaluation> BasicAI<Board<3, 3, 3>>::evaluate<Board<3, 3, 3>>(const vector<uint32_t>&);
+template vector<Evaluation> BasicAI<Board<4, 4, 4>>::evaluate<Board<4, 4, 4>>(const vector<uint32_t>&);
+template vector<Evaluation> BasicAI<Board<5, 5, 4>>::evaluate<Board<5, 5, 4>>(const vector<uint64_t>&);
\ No newline at end of file
@@ -0,0 +1,177 @@
+#pragma once
+#include "Board.h"
+#include "Encoding.h"
+#include "Search.h"
+#include "SolvedTable.h"
+#include "Symmetry.h"
+#include "ThreadPool.h"
+#include "TranspositionTable.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// BatchEvaluator finds the best move and the value of many positions in one call without changing them, so the
+// positions of many games can be coalesced into a batch. The positions are sorted by their packed form so the
+// same position is only searched once and the lookups of neighbouring positions stay close, then the sorted
+// positions are split in chunks that the workers of the pool search through one shared lock-free
+// transposition table. The 3x3 board reads the solved game table instead of searching
+template <typename BoardType>
+class BatchEvaluator {
+public:
+    using Packed = typename Encoding<BoardType>::Packed;
+
+    // the number of chunks of every worker, more chunks than workers keep them busy when positions take longer
+    static constexpr int CHUNKS_PER_WORKER = 4;
+
+private:
+    TranspositionTable& table; // the searched positions, shared by every worker
+    ThreadPool* pool; // the workers of the batch or nullptr to evaluate on the calling thread
+    SearchLimits limits; // the budget of the search of every position
+    bool useSolvedTable; // if the 3x3 positions are read from the solved game table
+
+    // return the evaluation of a position that can't be played from
+    static Evaluation terminal(const BoardType& board) {
+        Player last = (board.sideToMove() == X) ? O : X;
+        return Evaluation{ -1, board.hasWin(last) ? -WIN_SCORE : 0 };
+    }
+
+    // check if the packed form, unpacked to the board, is a position a game can reach: the halves share no cell
+    // and stay on the grid, the players took turns and only the player who moved last can have a line
+    static bool isLegal(Packed packed, const BoardType& board) {
+        Packed xCells = packed & Packed(BoardType::FULL);
+        Packed oCells = (packed >> Encoding<BoardType>::PACKED_SHIFT) & Packed(BoardType::FULL);
+        if ((xCells & oCells) != 0 || (xCells | (oCells << Encoding<BoardType>::PACKED_SHIFT)) != packed) {
+            return false;
+        }
+
+        int xCount = popCount(xCells);
+        int oCount = popCount(oCells);
+        if (xCount != oCount && xCount != oCount + 1) {
+            return false;
+        }
+
+        bool xWon = board.hasWin(X);
+        bool oWon = board.hasWin(O);
+
+        return !(xWon && oWon) && !(xWon && xCount == oCount) && !(oWon && xCount != oCount);
+    }
+
+    // evaluate one packed position
+    Evaluation evaluateOne(Packed packed) {
+        BoardType board = Encoding<BoardType>::unpack(packed);
+        if (!isLegal(packed, board)) {
+            return Evaluation{ -1, 0, false };
+        }
+        if (board.hasWin(X) || board.hasWin(O) || board.isFull()) {
+            return terminal(board);
+        }
+
+        // the solved table scores a win 10 - plies while the search scores it WIN_SCORE - plies
+        if constexpr (std::is_same<BoardType, Board<3, 3, 3>>::value) {
+            if (useSolvedTable) {
+                const SolvedEntry& entry = SOLVED_TABLE[static_cast<uint32_t>(Encoding<BoardType>::index(board))];
+                if (entry.bestCell >= 0) {
+                    int score = (entry.score > 0) ? WIN_SCORE - (10 - entry.score)
+                                : (entry.score < 0) ? -(WIN_SCORE - (10 + entry.score)) : 0;
+                    return Evaluation{ entry.bestCell, score };
+                }
+            }
+        }
+
+        Search<BoardType> search(table);
+        typename Search<BoardType>::Result best = search.iterativeDeepening(
+            board, BoardType::CELLS - board.moveCount(), Symmetry<BoardType>::uniqueMoves(board), limits);
+
+        return Evaluation{ best.cell, best.score };
+    }
+
+    // evaluate the positions from first to last of the sorted unique positions
+    void evaluateRange(const std::vector<Packed>& unique, std::vector<Evaluation>& results, size_t first,
+                       size_t last) {
+        for (size_t i = first; i < last; i++) {
+            results[i] = evaluateOne(unique[i]);
+        }
+    }
+
+public:
+    // constructor to initialize an evaluator that searches through the given table on the workers of the given
+    // pool, or on the calling thread if the pool is nullptr, with the given budget for every position
+    BatchEvaluator(TranspositionTable& transpositionTable, ThreadPool* threadPool,
+                   const SearchLimits& searchLimits = SearchLimits())
+        : table(transpositionTable), pool(threadPool), limits(searchLimits), useSolvedTable(true) {}
+
+    // choose if the 3x3 positions are read from the solved game table (the default) or searched
+    void setUseSolvedTable(bool use) {
+        useSolvedTable = use;
+    }
+
+    // evaluate the given number of packed positions and write the best move and value of position i for the
+    // player to move in results[i], the best move is -1 if the game is over or the position is illegal
+    void evaluate(const Packed* positions, size_t count, Evaluation* results) {
+        // the order of the positions after sorting them by their packed form
+        std::vector<std::pair<Packed, size_t>> order(count);
+        for (size_t i = 0; i < count; i++) {
+            order[i] = { positions[i], i };
+        }
+        std::sort(order.begin(), order.end());
+
+        // every position is searched only once
+        std::vector<Packed> unique;
+        std::vector<size_t> uniqueOf(count);
+        for (size_t i = 0; i < count; i++) {
+            if (unique.empty() || unique.back() != order[i].first) {
+                unique.push_back(order[i].first);
+            }
+            uniqueOf[order[i].second] = unique.size() - 1;
+        }
+
+        std::vector<Evaluation> uniqueResults(unique.size());
+        table.newSearch();
+
+        if (pool == nullptr || unique.size() < 2) {
+            evaluateRange(unique, uniqueResults, 0, unique.size());
+        }
+        else {
+            size_t chunks = std::min(unique.size(), static_cast<size_t>(pool->size()) * CHUNKS_PER_WORKER);
+            size_t chunkSize = (unique.size() + chunks - 1) / chunks;
+            std::vector<std::future<void>> futures;
+
+            for (size_t first = 0; first < unique.size(); first += chunkSize) {
+                size_t last = std::min(first + chunkSize, unique.size());
+                futures.push_back(pool->submit([this, &unique, &uniqueResults, first, last]() {
+                    evaluateRange(unique, uniqueResults, first, last);
+                }));
+            }
+
+            for (std::future<void>& future : futures) {
+                future.get();
+            }
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            results[i] = uniqueResults[uniqueOf[i]];
+        }
+    }
+
+    // evaluate the packed positions and return the best move and value of every one of them in the same order
+    std::vector<Evaluation> evaluate(const std::vector<Packed>& positions) {
+        std::vector<Evaluation> results(positions.size());
+        evaluate(positions.data(), positions.size(), results.data());
+
+        return results;
+    }
+
+    // evaluate the boards and return the best move and value of every one of them in the same order
+    std::vector<Evaluation> evaluate(const std::vector<BoardType>& boards) {
+        std::vector<Packed> positions(boards.size());
+        for (size_t i = 0; i < boards.size(); i++) {
+            positions[i] = Encoding<BoardType>::pack(boards[i]);
+        }
+
+        return evaluate(positions);
+    }
+};
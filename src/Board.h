@@ -0,0 +1,290 @@
+#pragma once
+#include "PlayerType.h"
+#include "Random.h"
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// the number of winning lines of length k on a rows x cols grid (rows, columns and both diagonal directions)
+constexpr int countWinLines(int rows, int cols, int k) {
+    int count = 0;
+
+    if (k <= cols) {
+        count += rows * (cols - k + 1); // rows
+    }
+    if (k <= rows) {
+        count += cols * (rows - k + 1); // columns
+    }
+    if (k <= rows && k <= cols) {
+        count += 2 * (rows - k + 1) * (cols - k + 1); // diagonals
+    }
+
+    return count;
+}
+
+// generate every winning line of length K as a mask where bit (row * Cols + column) is set for every cell
+// of the line, it is evaluated at compile time by Board
+template <typename Mask, int Rows, int Cols, int K>
+constexpr std::array<Mask, countWinLines(Rows, Cols, K)> makeWinLines() {
+    std::array<Mask, countWinLines(Rows, Cols, K)> lines{};
+    int count = 0;
+
+    // the four directions a line can go: right, down, down right and down left
+    const int directions[4][2] = { {0, 1}, {1, 0}, {1, 1}, {1, -1} };
+
+    for (const auto& direction : directions) {
+        for (int row = 0; row < Rows; row++) {
+            for (int col = 0; col < Cols; col++) {
+                int lastRow = row + direction[0] * (K - 1);
+                int lastCol = col + direction[1] * (K - 1);
+
+                // skip the lines that leave the grid
+                if (lastRow < 0 || lastRow >= Rows || lastCol < 0 || lastCol >= Cols) {
+                    continue;
+                }
+
+                Mask line = 0;
+                for (int i = 0; i < K; i++) {
+                    line |= Mask(1) << ((row + direction[0] * i) * Cols + col + direction[1] * i);
+                }
+                lines[count++] = line;
+            }
+        }
+    }
+
+    return lines;
+}
+
+// the winning lines that pass through one cell
+template <typename Mask, int MaxLines>
+struct CellLines {
+    int count = 0; // the number of lines through the cell
+    std::array<Mask, MaxLines> lines{}; // the masks of the lines through the cell
+};
+
+// generate for every cell the winning lines that pass through it, so a move only has to check its own lines
+template <typename Mask, int Rows, int Cols, int K>
+constexpr std::array<CellLines<Mask, 4 * K>, Rows * Cols> makeCellLines() {
+    std::array<CellLines<Mask, 4 * K>, Rows * Cols> cellLines{};
+    constexpr std::array<Mask, countWinLines(Rows, Cols, K)> lines = makeWinLines<Mask, Rows, Cols, K>();
+
+    for (int cell = 0; cell < Rows * Cols; cell++) {
+        for (Mask line : lines) {
+            if (line & (Mask(1) << cell)) {
+                cellLines[cell].lines[cellLines[cell].count++] = line;
+            }
+        }
+    }
+
+    return cellLines;
+}
+
+// the zobrist keys of a board, one random key for every (player, cell) pair and one for the side to move
+template <int Cells>
+struct ZobristKeys {
+    std::array<std::array<uint64_t, Cells>, 2> pieces{}; // the key of X and O in every cell
+    uint64_t side = 0; // toggled after every move so the same pieces with a different side to move differ
+};
+
+// generate the zobrist keys of a board, the seed depends on the board size so different sizes don't share keys
+template <int Rows, int Cols, int K>
+constexpr ZobristKeys<Rows * Cols> makeZobristKeys() {
+    ZobristKeys<Rows * Cols> keys{};
+    uint64_t state = (uint64_t(Rows) << 32) | (uint64_t(Cols) << 16) | uint64_t(K);
+
+    for (auto& player : keys.pieces) {
+        for (auto& key : player) {
+            key = splitMix64(state);
+        }
+    }
+    keys.side = splitMix64(state);
+
+    return keys;
+}
+
+// Board is a Rows x Cols grid where the first player to get K in a row wins, it keeps the cells as two
+// occupancy masks (X and O) and every size gets its own bounds, masks and win lines generated at compile
+// time, cell (row, column) is bit (row * Cols + column) of the masks
+template <int Rows, int Cols, int K>
+class Board {
+public:
+    static_assert(Rows > 0 && Cols > 0 && K > 0, "the board dimensions must be positive");
+    static_assert(K <= Rows || K <= Cols, "the win length must fit in the board");
+    static_assert(Rows * Cols <= 64, "the board must fit in a 64-bit mask");
+
+    // the smallest unsigned integer that has a bit for every cell
+    using Mask = typename std::conditional<(Rows * Cols <= 32), uint32_t, uint64_t>::type;
+
+    static constexpr int ROWS = Rows; // the number of rows
+    static constexpr int COLS = Cols; // the number of columns
+    static constexpr int CELLS = Rows * Cols; // the number of cells
+    static constexpr int WIN_LENGTH = K; // the number of pieces in a row needed to win
+    static constexpr int LINE_COUNT = countWinLines(Rows, Cols, K); // the number of winning lines
+
+    // the mask of the whole grid, a grid as wide as its mask can't shift a bit past its last cell
+    static constexpr Mask FULL = (CELLS == std::numeric_limits<Mask>::digits) ? ~Mask(0) : ((Mask(1) << CELLS) - 1);
+
+    // every winning line as a mask
+    static constexpr std::array<Mask, LINE_COUNT> LINES = makeWinLines<Mask, Rows, Cols, K>();
+
+    // the winning lines through every cell, a cell is crossed by at most K lines in each of the 4 directions
+    static constexpr std::array<CellLines<Mask, 4 * K>, CELLS> CELL_LINES = makeCellLines<Mask, Rows, Cols, K>();
+
+    // the zobrist keys used to hash the board
+    static constexpr ZobristKeys<CELLS> ZOBRIST = makeZobristKeys<Rows, Cols, K>();
+
+private:
+    Mask xMask; // the cells occupied by X
+    Mask oMask; // the cells occupied by O
+    int moves; // the number of occupied cells
+    uint64_t key; // the zobrist hash of the pieces and the side to move
+
+public:
+    // constructor to initialize an empty board
+    constexpr Board() : xMask(0), oMask(0), moves(0), key(0) {}
+
+    // build a board from the masks of both players, the masks must not overlap
+    static constexpr Board fromMasks(Mask xCells, Mask oCells) {
+        Board board;
+
+        for (int cell = 0; cell < CELLS; cell++) {
+            if (xCells & bit(cell)) {
+                board.place(cell, X);
+            }
+            else if (oCells & bit(cell)) {
+                board.place(cell, O);
+            }
+        }
+
+        return board;
+    }
+
+    // check if [row, column] is inside the board
+    static constexpr bool inBounds(int row, int column) {
+        return row >= 0 && row < Rows && column >= 0 && column < Cols;
+    }
+
+    // return the index of the cell at [row, column]
+    static constexpr int index(int row, int column) {
+        return row * Cols + column;
+    }
+
+    // return the mask with only the given cell set
+    static constexpr Mask bit(int cell) {
+        return Mask(1) << cell;
+    }
+
+    // check if the given mask contains a whole winning line
+    static constexpr bool isWinMask(Mask mask) {
+        for (int i = 0; i < LINE_COUNT; i++) {
+            if ((mask & LINES[i]) == LINES[i]) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // return the cell at the given index
+    constexpr Cell getCell(int cell) const {
+        if (xMask & bit(cell)) {
+            return XCell;
+        }
+        else if (oMask & bit(cell)) {
+            return OCell;
+        }
+
+        return Open;
+    }
+
+    // return the cells occupied by the given player
+    constexpr Mask getMask(Player player) const {
+        return (player == X) ? xMask : oMask;
+    }
+
+    // return the cells occupied by X
+    constexpr Mask getXMask() const {
+        return xMask;
+    }
+
+    // return the cells occupied by O
+    constexpr Mask getOMask() const {
+        return oMask;
+    }
+
+    // return the cells occupied by anyone
+    constexpr Mask occupied() const {
+        return xMask | oMask;
+    }
+
+    // return the open cells
+    constexpr Mask empty() const {
+        return FULL & ~(xMask | oMask);
+    }
+
+    // return the number of occupied cells
+    constexpr int moveCount() const {
+        return moves;
+    }
+
+    // return the zobrist hash of the board, it is kept up to date by place and remove
+    constexpr uint64_t hash() const {
+        return key;
+    }
+
+    // return the player that plays next, X always plays first
+    constexpr Player sideToMove() const {
+        return (moves % 2 == 0) ? X : O;
+    }
+
+    // check if every cell is occupied
+    constexpr bool isFull() const {
+        return moves == CELLS;
+    }
+
+    // check if the given player has a winning line
+    constexpr bool hasWin(Player player) const {
+        return isWinMask(getMask(player));
+    }
+
+    // check if the given player has a winning line through the given cell, only the lines of the last
+    // played cell can be completed by its move so this is all the win check needs after a move
+    constexpr bool isWinAt(int cell, Player player) const {
+        Mask mask = getMask(player);
+        const CellLines<Mask, 4 * K>& cellLines = CELL_LINES[cell];
+
+        for (int i = 0; i < cellLines.count; i++) {
+            if ((mask & cellLines.lines[i]) == cellLines.lines[i]) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // put the player's piece in the given cell, the cell must be open
+    constexpr void place(int cell, Player player) {
+        if (player == X) {
+            xMask |= bit(cell);
+        }
+        else {
+            oMask |= bit(cell);
+        }
+        moves++;
+        key ^= ZOBRIST.pieces[player][cell] ^ ZOBRIST.side;
+    }
+
+    // clear the given cell, the cell must be occupied
+    constexpr void remove(int cell) {
+        key ^= ZOBRIST.pieces[(xMask & bit(cell)) ? X : O][cell] ^ ZOBRIST.side;
+        xMask &= ~bit(cell);
+        oMask &= ~bit(cell);
+        moves--;
+    }
+
+    // check if two boards have the same pieces
+    constexpr bool operator==(const Board& other) const {
+        return xMask == other.xMask && oMask == other.oMask;
+    }
+};
@@ -0,0 +1,29 @@
+#pragma once
+#include "Board.h"
+
+// call visit with an empty board of the given rows, columns and pieces in a row and return true, or return false
+// if the size isn't supported, the board sizes are template arguments so only these are built:
+// 3x3 with 3, 4x4 with 4, 5x5 with 4, 6x6 with 4 and 7x7 with 5 in a row
+template <typename Visitor>
+bool withBoardSize(int rows, int cols, int k, Visitor visit) {
+    if (rows == 3 && cols == 3 && k == 3) {
+        visit(Board<3, 3, 3>());
+    }
+    else if (rows == 4 && cols == 4 && k == 4) {
+        visit(Board<4, 4, 4>());
+    }
+    else if (rows == 5 && cols == 5 && k == 4) {
+        visit(Board<5, 5, 4>());
+    }
+    else if (rows == 6 && cols == 6 && k == 4) {
+        visit(Board<6, 6, 4>());
+    }
+    else if (rows == 7 && cols == 7 && k == 5) {
+        visit(Board<7, 7, 5>());
+    }
+    else {
+        return false;
+    }
+
+    return true;
+}
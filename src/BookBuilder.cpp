@@ -0,0 +1,48 @@
+#include "BoardSizes.h"
+#include "OpeningBook.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+using namespace std;
+
+// search the openings of one board size and write them as a book
+template <typename BoardType>
+static bool build(int plies, const SearchLimits& limits, const string& path) {
+    TranspositionTable table(256);
+    vector<BookEntry> entries = buildOpeningBook<BoardType>(plies, limits, table);
+
+    cout << "searched " << entries.size() << " positions" << endl;
+    return OpeningBook::write(path, BoardType::ROWS, BoardType::COLS, BoardType::WIN_LENGTH, entries);
+}
+
+// BookBuilder <rows> <cols> <k> <plies> <milliseconds per position> <output file>
+int main(int argc, char* argv[]) {
+    if (argc != 7) {
+        cerr << "usage: BookBuilder <rows> <cols> <k> <plies> <milliseconds per position> <output file>" << endl;
+        return 1;
+    }
+
+    int rows = atoi(argv[1]);
+    int cols = atoi(argv[2]);
+    int k = atoi(argv[3]);
+    int plies = atoi(argv[4]);
+    SearchLimits limits;
+    limits.milliseconds = atoll(argv[5]);
+    string path = argv[6];
+    bool written = false;
+
+    bool supported = withBoardSize(rows, cols, k, [&](auto board) {
+        written = build<decltype(board)>(plies, limits, path);
+    });
+    if (!supported) {
+        cerr << "unsupported board " << rows << "x" << cols << " with " << k << " in a row" << endl;
+        return 1;
+    }
+
+    if (!written) {
+        cerr << "can't write " << path << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -2,26 +2,29 @@
 #include <iostream>
 using namespace std;
 
-Controller::Controller(PlayerType* x, PlayerType* o) {
+template <typename GameBoard>
+BasicController<GameBoard>::BasicController(BasicPlayerType<GameBoard>* x, BasicPlayerType<GameBoard>* o) {
     XType = x;
     OType = o;
 }
 
-Controller::~Controller() {
+template <typename GameBoard>
+BasicController<GameBoard>::~BasicController() {
     delete XType;
     delete OType;
 }
 
-void Controller::go(Model newGame) {
+template <typename GameBoard>
+void BasicController<GameBoard>::go(BasicModel<GameBoard> newGame) {
     // row and col that the player choose to play in every game
     int row, col;
 
     // the actual game loop
     while (!newGame.isTheGameOver()) {
         // display the grid
-        array<array<Cell, 3>, 3> grid = newGame.getGrid();
-        for (int i = 0; i < 3; i++) {
-            for (int j = 0; j < 3; j++) {
+        typename BasicModel<GameBoard>::Grid grid = newGame.getGrid();
+        for (int i = 0; i < GameBoard::ROWS; i++) {
+            for (int j = 0; j < GameBoard::COLS; j++) {
                 switch (grid[i][j]) {
                     case XCell:
                         cout << "X";
@@ -70,9 +73,9 @@ void Controller::go(Model newGame) {
     }
 
     // display the final grid
-    array<array<Cell, 3>, 3> grid = newGame.getGrid();
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 3; j++) {
+    typename BasicModel<GameBoard>::Grid grid = newGame.getGrid();
+    for (int i = 0; i < GameBoard::ROWS; i++) {
+        for (int j = 0; j < GameBoard::COLS; j++) {
             switch (grid[i][j]) {
                 case XCell:
                     cout << "X";
@@ -112,4 +115,11 @@ void Controller::go(Model newGame) {
             cout << "DAAHHH :)\n";
             break;
     }
-}
\ No newline at end of file
+}
+
+// the boards of withBoardSize
+template class BasicController<Board<3, 3, 3>>;
+template class BasicController<Board<4, 4, 4>>;
+template class BasicController<Board<5, 5, 4>>;
+template class BasicController<Board<6, 6, 4>>;
+template class BasicController<Board<7, 7, 5>>;
\ No newline at end of file
@@ -2,19 +2,25 @@
 #include "Model.h"
 #include "PlayerType.h"
 
-// the controller who controls the input and output during the game
-class Controller {
+// the controller who controls the input and output during the game, it is built for the boards of withBoardSize
+// (see BoardSizes.h) and Controller plays the classic 3x3 game
+template <typename GameBoard>
+class BasicController {
 private:
-    PlayerType* XType; // indicates the player type of X either Human or AI
-    PlayerType* OType; // indicates the player type of O either Human or AI
+    BasicPlayerType<GameBoard>* XType; // indicates the player type of X either Human or AI
+    BasicPlayerType<GameBoard>* OType; // indicates the player type of O either Human or AI
 
 public:
     // constructor to idendify the type of players that will play
-    Controller(PlayerType* x = new Human(), PlayerType* o = new AI(Normal));
+    BasicController(BasicPlayerType<GameBoard>* x = new BasicHuman<GameBoard>(),
+                    BasicPlayerType<GameBoard>* o = new BasicAI<GameBoard>(Normal));
 
     // destructor to make sure the memory is deallocated
-    ~Controller();
+    ~BasicController();
 
     // the gameplay
-    void go(Model newGame);
-};
\ No newline at end of file
+    void go(BasicModel<GameBoard> newGame);
+};
+
+// the controller of the classic game
+using Controller = BasicController<Board<3, 3, 3>>;
\ No newline at end of file
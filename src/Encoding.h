@@ -0,0 +1,116 @@
+#pragma once
+#include "Board.h"
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+// TERNARY[chunk][byte] of Encoding, the base-3 value of the 8 cells of the chunk when every set bit is a 1 digit
+template <int Cells, int Chunks>
+constexpr std::array<std::array<uint64_t, 256>, Chunks> makeTernaryTable() {
+    std::array<std::array<uint64_t, 256>, Chunks> table{};
+
+    for (int chunk = 0; chunk < Chunks; chunk++) {
+        uint64_t base = 1;
+        for (int i = 0; i < chunk * 8; i++) {
+            base *= 3;
+        }
+
+        for (int value = 0; value < 256; value++) {
+            uint64_t digits = 0;
+            uint64_t power = base;
+            for (int i = 0; i < 8 && chunk * 8 + i < Cells; i++) {
+                if (value & (1 << i)) {
+                    digits += power;
+                }
+                power *= 3;
+            }
+            table[chunk][value] = digits;
+        }
+    }
+
+    return table;
+}
+
+// Encoding turns a board into compact keys and back:
+// - the index is the base-3 number whose digit i is the cell i (0 open, 1 X, 2 O), it is dense so it can index
+//   arrays directly (0..19682 for 3x3) and it needs boards of at most 40 cells to fit 64 bits
+// - the packed form is the X mask in the low half and the O mask in the high half, 32 bits for boards of at
+//   most 16 cells and 64 bits for boards of at most 32 cells
+template <typename BoardType>
+class Encoding {
+public:
+    using Mask = typename BoardType::Mask;
+    using Packed = typename std::conditional<(BoardType::CELLS <= 16), uint32_t, uint64_t>::type;
+
+    // the number of 8-bit chunks of a mask
+    static constexpr int CHUNKS = (BoardType::CELLS + 7) / 8;
+
+    // the number of bits of every half of the packed form
+    static constexpr int PACKED_SHIFT = (BoardType::CELLS <= 16) ? 16 : 32;
+
+    // the base-3 value of every byte of a mask
+    static constexpr std::array<std::array<uint64_t, 256>, CHUNKS> TERNARY = makeTernaryTable<BoardType::CELLS, CHUNKS>();
+
+    // return the number of possible indices (3 ^ cells)
+    static constexpr uint64_t indexCount() {
+        static_assert(BoardType::CELLS <= 40, "the base-3 index only fits boards of at most 40 cells");
+
+        uint64_t count = 1;
+        for (int i = 0; i < BoardType::CELLS; i++) {
+            count *= 3;
+        }
+
+        return count;
+    }
+
+    // return the base-3 index of the board, a table lookup for every byte of the masks
+    static constexpr uint64_t index(const BoardType& board) {
+        static_assert(BoardType::CELLS <= 40, "the base-3 index only fits boards of at most 40 cells");
+
+        uint64_t result = 0;
+        for (int chunk = 0; chunk < CHUNKS; chunk++) {
+            result += TERNARY[chunk][(board.getXMask() >> (chunk * 8)) & 0xFF];
+            result += 2 * TERNARY[chunk][(board.getOMask() >> (chunk * 8)) & 0xFF];
+        }
+
+        return result;
+    }
+
+    // return the board of the given base-3 index
+    static constexpr BoardType fromIndex(uint64_t index) {
+        static_assert(BoardType::CELLS <= 40, "the base-3 index only fits boards of at most 40 cells");
+
+        Mask xCells = 0;
+        Mask oCells = 0;
+
+        for (int cell = 0; cell < BoardType::CELLS; cell++) {
+            switch (index % 3) {
+                case 1:
+                    xCells |= BoardType::bit(cell);
+                    break;
+                case 2:
+                    oCells |= BoardType::bit(cell);
+                    break;
+                default:
+                    break;
+            }
+            index /= 3;
+        }
+
+        return BoardType::fromMasks(xCells, oCells);
+    }
+
+    // return the packed form of the board
+    static constexpr Packed pack(const BoardType& board) {
+        static_assert(BoardType::CELLS <= 32, "the packed form only fits boards of at most 32 cells");
+
+        return Packed(board.getXMask()) | (Packed(board.getOMask()) << PACKED_SHIFT);
+    }
+
+    // return the board of the given packed form
+    static constexpr BoardType unpack(Packed packed) {
+        static_assert(BoardType::CELLS <= 32, "the packed form only fits boards of at most 32 cells");
+
+        return BoardType::fromMasks(Mask(packed & BoardType::FULL), Mask((packed >> PACKED_SHIFT) & BoardType::FULL));
+    }
+};
@@ -0,0 +1,204 @@
+#pragma once
+#include "Board.h"
+#include "MoveGen.h"
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// the indices of the winning lines that pass through one cell
+template <int MaxLines>
+struct CellLineIndices {
+    int count = 0; // the number of lines through the cell
+    std::array<int, MaxLines> lines{}; // the indices of the lines through the cell in BoardType::LINES
+};
+
+// CELL_LINE_INDICES of LineEvaluator, for every cell the indices of the lines through it
+template <typename Mask, int Cells, int LineCount, int K>
+constexpr std::array<CellLineIndices<4 * K>, Cells> makeCellLineIndices(const std::array<Mask, LineCount>& lines) {
+    std::array<CellLineIndices<4 * K>, Cells> cells{};
+
+    for (int cell = 0; cell < Cells; cell++) {
+        for (int line = 0; line < LineCount; line++) {
+            if (lines[line] & (Mask(1) << cell)) {
+                cells[cell].lines[cells[cell].count++] = line;
+            }
+        }
+    }
+
+    return cells;
+}
+
+// WEIGHTS of LineEvaluator, 4 ^ (n - 1) for n pieces in a line of K cells, a complete line ends the game before
+// it is evaluated so it is worth 0
+template <int K>
+constexpr std::array<int8_t, 8> makeLineWeights() {
+    std::array<int8_t, 8> weights{};
+
+    for (int pieces = 1; pieces < K; pieces++) {
+        weights[pieces] = static_cast<int8_t>(1 << (2 * (pieces - 1)));
+    }
+
+    return weights;
+}
+
+// ZeroEvaluator scores every position the search can't see the end of as a draw, the search then only knows
+// the wins and losses it reaches, it is the evaluator for boards that are always searched to the end
+template <typename BoardType>
+class ZeroEvaluator {
+public:
+    // the biggest score of a position
+    static constexpr int MAX_SCORE = 0;
+
+    // start from the pieces of the board
+    void reset(const BoardType&) {}
+
+    // update the scores after the player put a piece in the cell
+    void place(int, Player) {}
+
+    // update the scores after the piece of the player in the cell is removed
+    void remove(int, Player) {}
+
+    // return the score of the position for the given player
+    int evaluate(Player) const {
+        return 0;
+    }
+};
+
+// LineEvaluator scores a position by its open lines: a line with n pieces of one player and none of the other
+// is worth 4 ^ (n - 1) to that player, so one more piece in a line is worth more than three lines with one
+// piece less, and the score is the worth of the lines of the player minus the worth of the lines of the
+// opponent
+//
+// the pieces of both players are counted per line in byte arrays: a move only updates the counts and the
+// running score of the lines through its cell so evaluate() is free, and reset() scores every line from the
+// counts 16 lines at a time with SSE2 where it is available
+template <typename BoardType>
+class LineEvaluator {
+public:
+    using Mask = typename BoardType::Mask;
+
+    static_assert(BoardType::WIN_LENGTH <= 5, "the worth of a line must fit in a byte");
+
+    // the number of lines rounded up to a multiple of 16, the padding lines have no pieces and are worth 0
+    static constexpr int PADDED_LINES = (BoardType::LINE_COUNT + 15) / 16 * 16;
+
+    // the worth of an open line by its number of pieces
+    static constexpr std::array<int8_t, 8> WEIGHTS = makeLineWeights<BoardType::WIN_LENGTH>();
+
+    // the biggest score of a position, every line worth the most
+    static constexpr int MAX_SCORE = BoardType::LINE_COUNT * WEIGHTS[BoardType::WIN_LENGTH - 1];
+
+    // the lines through every cell
+    static constexpr std::array<CellLineIndices<4 * BoardType::WIN_LENGTH>, BoardType::CELLS> CELL_LINE_INDICES =
+        makeCellLineIndices<Mask, BoardType::CELLS, BoardType::LINE_COUNT, BoardType::WIN_LENGTH>(
+            BoardType::LINES);
+
+private:
+    alignas(16) std::array<std::array<int8_t, PADDED_LINES>, 2> counts; // the pieces of X and O in every line
+    int score; // the score of the position for X
+
+    // return the worth of a line for X with the given pieces of X and O
+    static int lineWorth(int xCount, int oCount) {
+        return ((oCount == 0) ? WEIGHTS[xCount] : 0) - ((xCount == 0) ? WEIGHTS[oCount] : 0);
+    }
+
+    // move the counts and the score of the lines of the cell by one piece of the player
+    void update(int cell, Player player, int8_t delta) {
+        const CellLineIndices<4 * BoardType::WIN_LENGTH>& cellLines = CELL_LINE_INDICES[cell];
+
+        for (int i = 0; i < cellLines.count; i++) {
+            int line = cellLines.lines[i];
+            score -= lineWorth(counts[X][line], counts[O][line]);
+            counts[player][line] += delta;
+            score += lineWorth(counts[X][line], counts[O][line]);
+        }
+    }
+
+public:
+    // constructor to initialize the scores of an empty board
+    LineEvaluator() {
+        reset(BoardType());
+    }
+
+    // count the pieces of every line of the board and score them all
+    void reset(const BoardType& board) {
+        counts[X].fill(0);
+        counts[O].fill(0);
+
+        for (int line = 0; line < BoardType::LINE_COUNT; line++) {
+            counts[X][line] = static_cast<int8_t>(popCount(board.getXMask() & BoardType::LINES[line]));
+            counts[O][line] = static_cast<int8_t>(popCount(board.getOMask() & BoardType::LINES[line]));
+        }
+
+        score = scoreLines();
+    }
+
+    // update the scores after the player put a piece in the cell
+    void place(int cell, Player player) {
+        update(cell, player, 1);
+    }
+
+    // update the scores after the piece of the player in the cell is removed
+    void remove(int cell, Player player) {
+        update(cell, player, -1);
+    }
+
+    // return the score of the position for the given player
+    int evaluate(Player player) const {
+        return (player == X) ? score : -score;
+    }
+
+    // score every line from the counts for X, the running score always equals it
+    int scoreLines() const {
+#if defined(__SSE2__)
+        const __m128i zero = _mm_setzero_si128();
+        __m128i xSum = zero;
+        __m128i oSum = zero;
+
+        for (int line = 0; line < PADDED_LINES; line += 16) {
+            __m128i x = _mm_load_si128(reinterpret_cast<const __m128i*>(&counts[X][line]));
+            __m128i o = _mm_load_si128(reinterpret_cast<const __m128i*>(&counts[O][line]));
+
+            // the worth of every line is picked by comparing its count with every count that is worth something
+            __m128i xWorth = zero;
+            __m128i oWorth = zero;
+            for (int pieces = 1; pieces < BoardType::WIN_LENGTH; pieces++) {
+                __m128i count = _mm_set1_epi8(static_cast<char>(pieces));
+                __m128i weight = _mm_set1_epi8(WEIGHTS[pieces]);
+                xWorth = _mm_or_si128(xWorth, _mm_and_si128(_mm_cmpeq_epi8(x, count), weight));
+                oWorth = _mm_or_si128(oWorth, _mm_and_si128(_mm_cmpeq_epi8(o, count), weight));
+            }
+
+            // only the lines without pieces of the other player are open, the bytes are summed 8 at a time
+            xWorth = _mm_and_si128(xWorth, _mm_cmpeq_epi8(o, zero));
+            oWorth = _mm_and_si128(oWorth, _mm_cmpeq_epi8(x, zero));
+            xSum = _mm_add_epi64(xSum, _mm_sad_epu8(xWorth, zero));
+            oSum = _mm_add_epi64(oSum, _mm_sad_epu8(oWorth, zero));
+        }
+
+        __m128i sum = _mm_sub_epi64(xSum, oSum);
+        return _mm_cvtsi128_si32(sum) + _mm_cvtsi128_si32(_mm_unpackhi_epi64(sum, sum));
+#else
+        int total = 0;
+        for (int line = 0; line < BoardType::LINE_COUNT; line++) {
+            total += lineWorth(counts[X][line], counts[O][line]);
+        }
+
+        return total;
+#endif
+    }
+};
+
+// the biggest board a search always finishes, the 3x3 board: its search reaches the end of every game so it never
+// evaluates a position and following the moves would only cost time
+constexpr int FULL_SEARCH_CELLS = 9;
+
+// the evaluator of a search by default, ZeroEvaluator for the boards that are searched to the end and
+// LineEvaluator for the ones whose search stops at a depth limit
+template <typename BoardType>
+using DefaultEvaluator = typename std::conditional<(BoardType::CELLS <= FULL_SEARCH_CELLS), ZeroEvaluator<BoardType>,
+                                                   LineEvaluator<BoardType>>::type;
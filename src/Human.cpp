@@ -3,11 +3,20 @@
 #include <iostream>
 using namespace std;
 
-void Human::play(Player player, Model& game, int row, int col) {
+template <typename GameBoard>
+void BasicHuman<GameBoard>::play(Player player, BasicModel<GameBoard>& game, int row, int col) {
     game.play(row, col);
     game.updateStatus();
 }
 
-bool Human::isHuman() {
+template <typename GameBoard>
+bool BasicHuman<GameBoard>::isHuman() {
         return true;
-}
\ No newline at end of file
+}
+
+// the boards of withBoardSize
+template class BasicHuman<Board<3, 3, 3>>;
+template class BasicHuman<Board<4, 4, 4>>;
+template class BasicHuman<Board<5, 5, 4>>;
+template class BasicHuman<Board<6, 6, 4>>;
+template class BasicHuman<Board<7, 7, 5>>;
\ No newline at end of file
@@ -0,0 +1,362 @@
+#pragma once
+#include "Board.h"
+#include "MoveGen.h"
+#include "Playout.h"
+#include "Random.h"
+#include "Search.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Mcts is the Monte Carlo tree search of the AI for boards too big to search to the end, every iteration walks
+// down the tree by UCT, adds the children of the reached node, finishes the game with random moves and adds
+// the result to every node of the walk. The nodes live in an arena allocated once, the children of a node are
+// next to each other so a node only keeps the index of its first child, and the subtree of the position
+// reached after the next moves is kept for the next search
+template <typename BoardType>
+class Mcts {
+public:
+    using Mask = typename BoardType::Mask;
+
+    // the default number of nodes of the arena
+    static constexpr int DEFAULT_CAPACITY = 1 << 18;
+
+    // the number of playouts of a search without any limit
+    static constexpr uint64_t DEFAULT_PLAYOUTS = 20000;
+
+    // the number of games the ai plays out from every reached node, a quarter of a PlayoutBatch keeps the tree
+    // growing while the bit-sliced games still cost a fraction of single ones
+    static constexpr int AI_BATCH_SIZE = 16;
+
+    // the exploration constant of UCT
+    static constexpr double EXPLORATION = 1.41;
+
+    // one position of the tree
+    struct Node {
+        int cell; // the move that led to the position or -1 for the first root
+        int firstChild; // the index of the first child or -1 if the children aren't added yet
+        int childCount; // the number of children
+        uint32_t visits; // the number of playouts through the position
+        float wins; // the wins of the player who played cell, a draw counts as half a win
+        bool terminal; // if the game is over in the position
+        bool won; // if the player who played cell won, only meaningful when terminal
+    };
+
+    // the result of a search
+    struct Result {
+        int cell; // the most visited cell or -1 if there is no move
+        uint32_t visits; // the number of playouts through the cell
+        double value; // the win rate of the cell for the player to move, a draw counts as half a win
+    };
+
+private:
+    std::vector<Node> arena; // the nodes of the tree, the root first
+    std::vector<Node> spare; // the arena the kept subtree is copied to when the root moves
+    int used; // the number of used nodes of the arena
+    BoardType rootBoard; // the position of the root
+    Random random; // the random generator of the playouts
+    PlayoutBatch<BoardType> batch; // the kernel of the batched playouts
+    int batchSize; // the number of games played out from every reached node, 1 plays a single scalar game
+    const std::atomic<bool>* stopFlag; // set by another thread to stop the search or nullptr
+    uint64_t playouts; // the number of playouts of the last search
+    double seconds; // the wall-clock duration of the last search
+
+    // make the tree a single root of the given position
+    void reset(const BoardType& board) {
+        rootBoard = board;
+        arena[0] = Node{ -1, -1, 0, 0, 0.0f, false, false };
+        used = 1;
+    }
+
+    // copy the subtree of the given node to the front of the spare arena and make it the tree, the children of
+    // every node stay next to each other since they are copied together
+    void compact(int newRoot) {
+        spare[0] = arena[newRoot];
+        int count = 1;
+
+        for (int i = 0; i < count; i++) {
+            Node& node = spare[i];
+
+            if (node.firstChild >= 0) {
+                int first = count;
+                for (int child = 0; child < node.childCount; child++) {
+                    spare[count++] = arena[node.firstChild + child];
+                }
+                node.firstChild = first;
+            }
+        }
+
+        std::swap(arena, spare);
+        used = count;
+    }
+
+    // move the root down the tree to the given position if it follows the root, otherwise start a new tree
+    void advance(const BoardType& board) {
+        Mask xNew = board.getXMask() & ~rootBoard.getXMask();
+        Mask oNew = board.getOMask() & ~rootBoard.getOMask();
+        bool follows = used > 0 && (rootBoard.getXMask() & ~board.getXMask()) == 0 &&
+                       (rootBoard.getOMask() & ~board.getOMask()) == 0;
+
+        BoardType current = rootBoard;
+        int node = 0;
+
+        // every played cell is found among the children of the side that played it, any order reaches the
+        // same position
+        while (follows && (xNew | oNew)) {
+            Mask& played = (current.sideToMove() == X) ? xNew : oNew;
+            int next = -1;
+
+            for (int child = 0; child < arena[node].childCount && next < 0; child++) {
+                int index = arena[node].firstChild + child;
+                if (played & BoardType::bit(arena[index].cell)) {
+                    next = index;
+                }
+            }
+
+            if (next < 0) {
+                follows = false;
+                break;
+            }
+
+            current.place(arena[next].cell, current.sideToMove());
+            played &= ~BoardType::bit(arena[next].cell);
+            node = next;
+        }
+
+        if (!follows) {
+            reset(board);
+        }
+        else if (node != 0) {
+            rootBoard = board;
+            compact(node);
+        }
+    }
+
+    // add the children of the node if the arena has room, the children of a winning move are marked
+    // terminal so they are never expanded or played out
+    void expand(int index, BoardType& board) {
+        MoveList<BoardType::CELLS> moves(board.empty());
+        if (moves.empty() || used + moves.size() > static_cast<int>(arena.size())) {
+            return;
+        }
+
+        Player side = board.sideToMove();
+        arena[index].firstChild = used;
+        arena[index].childCount = moves.size();
+
+        for (int cell : moves) {
+            board.place(cell, side);
+            bool won = board.isWinAt(cell, side);
+            arena[used++] = Node{ cell, -1, 0, 0, 0.0f, won || board.isFull(), won };
+            board.remove(cell);
+        }
+    }
+
+    // pick the child of the node with the best UCT value, the unvisited children first
+    int select(int index) const {
+        const Node& node = arena[index];
+        double logVisits = std::log(static_cast<double>(node.visits) + 1.0);
+        int best = -1;
+        double bestValue = -1.0;
+
+        for (int child = 0; child < node.childCount; child++) {
+            const Node& next = arena[node.firstChild + child];
+
+            if (next.visits == 0) {
+                return node.firstChild + child;
+            }
+
+            double value = next.wins / next.visits + EXPLORATION * std::sqrt(logVisits / next.visits);
+            if (value > bestValue) {
+                bestValue = value;
+                best = node.firstChild + child;
+            }
+        }
+
+        return best;
+    }
+
+    // play random moves until the game is over and return the winner, or -1 for a draw
+    int playout(BoardType& board) {
+        while (!board.isFull()) {
+            Mask open = board.empty();
+            int cell = nthBit(open, random.below(popCount(open)));
+            Player side = board.sideToMove();
+
+            board.place(cell, side);
+            if (board.isWinAt(cell, side)) {
+                return side;
+            }
+        }
+
+        return -1;
+    }
+
+    // return the score of X and O of a game with the given winner, or -1 for a draw
+    static std::array<float, 2> winnerScores(int winner) {
+        if (winner == -1) {
+            return { 0.5f, 0.5f };
+        }
+
+        return { (winner == X) ? 1.0f : 0.0f, (winner == O) ? 1.0f : 0.0f };
+    }
+
+    // run one iteration from the root and return false if the root has no move
+    bool iterate() {
+        std::array<int, BoardType::CELLS + 1> path;
+        int length = 0;
+        BoardType board = rootBoard;
+        int index = 0;
+        path[length++] = index;
+
+        // walk down by UCT while the children are known
+        while (!arena[index].terminal && arena[index].firstChild >= 0) {
+            index = select(index);
+            board.place(arena[index].cell, board.sideToMove());
+            path[length++] = index;
+        }
+
+        // a node seen once gets its children and the walk goes one step more
+        if (!arena[index].terminal && (arena[index].visits > 0 || index == 0)) {
+            expand(index, board);
+            if (arena[index].firstChild >= 0) {
+                index = select(index);
+                board.place(arena[index].cell, board.sideToMove());
+                path[length++] = index;
+            }
+            else if (index == 0 && board.empty() == 0) {
+                return false;
+            }
+        }
+
+        // the results of the games from the reached position, a draw counts as half a win for both sides
+        uint32_t games = 1;
+        std::array<float, 2> scores = { 0.0f, 0.0f };
+        if (arena[index].terminal) {
+            scores = winnerScores(arena[index].won ? ((board.sideToMove() == X) ? O : X) : -1);
+        }
+        else if (batchSize > 1) {
+            typename PlayoutBatch<BoardType>::Outcome outcome = batch.run(board, batchSize);
+            float draws = 0.5f * popCount(outcome.draws);
+
+            games = batchSize;
+            scores = { popCount(outcome.xWins) + draws, popCount(outcome.oWins) + draws };
+        }
+        else {
+            scores = winnerScores(playout(board));
+        }
+
+        // every node is scored for the player who played its cell, the one before the side to move of its board
+        Player mover = (rootBoard.sideToMove() == X) ? O : X;
+        for (int i = 0; i < length; i++) {
+            Node& node = arena[path[i]];
+            node.visits += games;
+            node.wins += scores[mover];
+            mover = (mover == X) ? O : X;
+        }
+
+        playouts += games;
+        return true;
+    }
+
+public:
+    // constructor to initialize an empty tree of at most the given number of nodes and the random generator
+    explicit Mcts(int capacity = DEFAULT_CAPACITY, uint64_t seed = 0)
+        : arena(std::max(capacity, BoardType::CELLS + 1)), spare(arena.size()), used(0), random(seed),
+          batch(seed), batchSize(1), stopFlag(nullptr), playouts(0),
+          seconds(0.0) {}
+
+    // restart the random generator of the playouts from the given seed
+    void setSeed(uint64_t seed) {
+        random = Random::stream(seed, 0);
+        batch.setSeed(seed);
+    }
+
+    // play the given number of games (1 to PlayoutBatch::LANES) from every reached node at once, every game
+    // counts as one playout so the playout limit can be passed by less than a batch
+    void setBatchSize(int games) {
+        batchSize = std::min(std::max(games, 1), PlayoutBatch<BoardType>::LANES);
+    }
+
+    // stop the search as soon as the given flag is set by another thread, nullptr removes the flag, the first
+    // playout always runs so there is a move
+    void setStopFlag(const std::atomic<bool>* flag) {
+        stopFlag = flag;
+    }
+
+    // forget the tree
+    void clear() {
+        used = 0;
+    }
+
+    // search the position until the limits run out, the nodes limit is the number of playouts, and return the
+    // most visited move, the tree below the position is kept for the next search
+    Result search(const BoardType& board, const SearchLimits& limits) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point deadline = start + std::chrono::milliseconds(limits.milliseconds);
+        uint64_t maxPlayouts = limits.nodes;
+        if (limits.nodes == 0 && limits.milliseconds <= 0) {
+            maxPlayouts = DEFAULT_PLAYOUTS;
+        }
+
+        advance(board);
+        playouts = 0;
+
+        // the clock is only read every 64 playouts
+        while (maxPlayouts == 0 || playouts < maxPlayouts) {
+            if (!iterate()) {
+                break;
+            }
+            if (limits.milliseconds > 0 && (playouts & 63) == 0 && std::chrono::steady_clock::now() >= deadline) {
+                break;
+            }
+            if (stopFlag != nullptr && stopFlag->load(std::memory_order_relaxed)) {
+                break;
+            }
+        }
+
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // the most visited child is the most trusted one
+        Result result = { -1, 0, 0.0 };
+        const Node& root = arena[0];
+        for (int child = 0; child < root.childCount; child++) {
+            const Node& node = arena[root.firstChild + child];
+            if (result.cell < 0 || node.visits > result.visits) {
+                result = Result{ node.cell, node.visits, (node.visits > 0) ? node.wins / node.visits : 0.0 };
+            }
+        }
+
+        return result;
+    }
+
+    // return the number of playouts of the last search
+    uint64_t getPlayouts() const {
+        return playouts;
+    }
+
+    // return the number of playouts per second of the last search
+    double getPlayoutsPerSecond() const {
+        return (seconds > 0.0) ? playouts / seconds : 0.0;
+    }
+
+    // return the number of playouts through the root, it includes the ones kept from the previous searches
+    uint32_t getRootVisits() const {
+        return (used > 0) ? arena[0].visits : 0;
+    }
+
+    // return the number of used nodes of the arena
+    int getNodeCount() const {
+        return used;
+    }
+
+    // return the number of nodes the arena can hold
+    int getCapacity() const {
+        return static_cast<int>(arena.size());
+    }
+};
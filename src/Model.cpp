@@ -3,67 +3,93 @@
 #include <limits>
 using namespace std;
 
-Model::Model() {
+template <typename GameBoard>
+BasicModel<GameBoard>::BasicModel() {
     // setting all the cells in the grid as open
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 3; j++) {
-            grid[i][j] = Open;
-        }
-    }
+    board = BoardType();
 
     status = Playing; // set the status as playing
     lastPlayed = O; // set the lastPlayed as O to insure that X always plays first
+    history = {}; // no move is played yet
+    moves = 0;
+    redoMoves = 0;
 }
 
-Player Model::whoIsNext() {
+template <typename GameBoard>
+Player BasicModel<GameBoard>::whoIsNext() {
     // check if the game is over
     if (isTheGameOver()) {
         throw IllegalStateException();
     }
 
-    switch (lastPlayed) {
-        case X:
-            return O;
+    return sideToMove();
+}
+
+template <typename GameBoard>
+void BasicModel<GameBoard>::play(int row, int column) {
+    switch (tryPlay(row, column)) {
+        case OutOfBounds:
+        case CellTaken:
+            throw IllegalCellException();
             break;
-        case O:
-            return X;
+        case GameOver:
+            throw IllegalStateException();
             break;
         default:
-            return X;
             break;
-    } 
+    }
 }
 
-void Model::play(int row, int column) {
+template <typename GameBoard>
+Player BasicModel<GameBoard>::sideToMove() const {
+    return (lastPlayed == X) ? O : X;
+}
+
+template <typename GameBoard>
+MoveResult BasicModel<GameBoard>::tryPlay(int row, int column) {
     // check if the cell isn't out of boundries
-    if (row > 2 || row < 0 || column > 2 || column < 0) {
-        throw IllegalCellException();
+    if (!BoardType::inBounds(row, column)) {
+        return OutOfBounds;
     }
+
+    int cell = BoardType::index(row, column);
+
     // check if the cell isn't empty
-    else if (grid[row][column] != Open) {
-        throw IllegalCellException();
+    if (board.occupied() & BoardType::bit(cell)) {
+        return CellTaken;
     }
-    
-    // check who is the next player that should play to put its symbol in the chosen cell
-    switch (whoIsNext()) {
-        case X: 
-            grid[row][column] = XCell;
-            lastPlayed = X;
-            break;
-        case O:
-            grid[row][column] = OCell;
-            lastPlayed = O;
-            break;
-        default:
-            grid[row][column] = Open;
-            lastPlayed = O;
-            break;
+    // check if the game is already over
+    if (isTheGameOver()) {
+        return GameOver;
     }
 
-    return;
+    playUnchecked(cell);
+    return Played;
+}
+
+template <typename GameBoard>
+void BasicModel<GameBoard>::playUnchecked(int cell) {
+    // a new move drops the moves that could be redone
+    redoMoves = moves;
+    applyMove(cell);
 }
 
-bool Model::isTheGameOver() {
+template <typename GameBoard>
+void BasicModel<GameBoard>::applyMove(int cell) {
+    // put the symbol of the next player in the chosen cell
+    lastPlayed = sideToMove();
+    board.place(cell, lastPlayed);
+
+    history[moves++] = cell;
+    if (redoMoves < moves) {
+        redoMoves = moves;
+    }
+
+    updateStatus();
+}
+
+template <typename GameBoard>
+bool BasicModel<GameBoard>::isTheGameOver() {
     switch (status) {
         case Playing: 
             return false;
@@ -80,27 +106,44 @@ bool Model::isTheGameOver() {
     }
 }
 
-array<array<Cell, 3>, 3> Model::getGrid() {
+template <typename GameBoard>
+typename BasicModel<GameBoard>::Grid BasicModel<GameBoard>::getGrid() {
+    Grid grid;
+
+    // rebuild the grid from the masks
+    for (int i = 0; i < BoardType::ROWS; i++) {
+        for (int j = 0; j < BoardType::COLS; j++) {
+            grid[i][j] = board.getCell(BoardType::index(i, j));
+        }
+    }
+
     return grid;
 }
 
-Cell Model::getCell(int row, int column) {
+template <typename GameBoard>
+Cell BasicModel<GameBoard>::getCell(int row, int column) {
     // check if the cell isn't out of boundries
-    if (row > 2 || row < 0 || column > 2 || column < 0) {
+    if (!BoardType::inBounds(row, column)) {
         throw IllegalCellException();
     }
 
-    return grid[row][column];
+    return board.getCell(BoardType::index(row, column));
 }
 
-void Model::updateStatus() {
-    // check if there is a winner
-    if (checkWin()) {
+template <typename GameBoard>
+void BasicModel<GameBoard>::updateStatus() {
+    // nothing is played yet
+    if (moves == 0) {
+        return;
+    }
+
+    // check if the last move completed a line
+    if (board.isWinAt(history[moves - 1], lastPlayed)) {
         status = Win;
         return;
     }
-    // check if there is a draw
-    if (checkDraw()) {
+    // check if there is a draw, the grid is full and the last move didn't win
+    if (board.isFull()) {
         status = Draw;
         return;
     }
@@ -108,49 +151,25 @@ void Model::updateStatus() {
     return;
 }
 
-bool Model::checkWin() {
-    Cell winner = (lastPlayed == X) ? XCell : OCell; // put the last played player as the possible winner
-    
-    // check the win through rows and columns
-    for (int i = 0; i < 3; i++) {
-        // check if it's a row win
-        if (grid[i][0] == winner && grid[i][1] == winner && grid[i][2] == winner) {
-            return true;
-        }
-        // check if it's a column win
-        else if (grid[0][i] == winner && grid[1][i] == winner && grid[2][i] == winner) {
-            return true;
-        }
-    }
-
-    // check if it's a diagonal win
-    if (grid[0][0] == winner && grid[1][1] == winner && grid[2][2] == winner) {
-        return true;
-    }
-    else if (grid[0][2] == winner && grid[1][1] == winner && grid[2][0] == winner) {
-        return true;
-    }
-
-    return false;
+template <typename GameBoard>
+bool BasicModel<GameBoard>::checkWin() {
+    // the last played player is the only possible winner
+    return board.hasWin(lastPlayed);
 }
 
-bool Model::checkDraw() {
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 3; j++) {
-            if (grid[i][j] == Open) {
-                return false;
-            }
-        }
-    }
-
-    return !checkWin();
+template <typename GameBoard>
+bool BasicModel<GameBoard>::checkDraw() {
+    // the grid must be full without a winner
+    return board.isFull() && !checkWin();
 }
 
-Status Model::getStatus() {
+template <typename GameBoard>
+Status BasicModel<GameBoard>::getStatus() {
     return status;
 }
 
-Player Model::getWinner() {
+template <typename GameBoard>
+Player BasicModel<GameBoard>::getWinner() {
     if (status == Win) {
         return lastPlayed;
     }
@@ -159,8 +178,84 @@ Player Model::getWinner() {
     }
 }
 
-void Model::undo(int row, int column) {
-    grid[row][column] = Open;
+template <typename GameBoard>
+void BasicModel<GameBoard>::undo(int row, int column) {
+    // only the last move can be undone
+    if (moves == 0 || !BoardType::inBounds(row, column) || history[moves - 1] != BoardType::index(row, column)) {
+        throw IllegalCellException();
+    }
+
+    undo();
+}
+
+template <typename GameBoard>
+bool BasicModel<GameBoard>::undo() {
+    // check if there is a move to undo
+    if (moves == 0) {
+        return false;
+    }
+
+    board.remove(history[--moves]);
     lastPlayed = (lastPlayed == X) ? O : X;
+
+    // no move is played after the end of the game so the status before the last move was playing
     status = Playing;
-}
\ No newline at end of file
+    return true;
+}
+
+template <typename GameBoard>
+bool BasicModel<GameBoard>::redo() {
+    // check if there is a move to redo
+    if (moves == redoMoves) {
+        return false;
+    }
+
+    applyMove(history[moves]);
+    return true;
+}
+
+template <typename GameBoard>
+bool BasicModel<GameBoard>::canRedo() const {
+    return moves < redoMoves;
+}
+
+template <typename GameBoard>
+Move BasicModel<GameBoard>::lastMove() const {
+    if (moves == 0) {
+        return Move{ -1, -1 };
+    }
+
+    return Move{ history[moves - 1] / BoardType::COLS, history[moves - 1] % BoardType::COLS };
+}
+
+template <typename GameBoard>
+int BasicModel<GameBoard>::moveCount() const {
+    return moves;
+}
+
+template <typename GameBoard>
+typename BasicModel<GameBoard>::Mask BasicModel<GameBoard>::getXMask() const {
+    return board.getXMask();
+}
+
+template <typename GameBoard>
+typename BasicModel<GameBoard>::Mask BasicModel<GameBoard>::getOMask() const {
+    return board.getOMask();
+}
+
+template <typename GameBoard>
+uint64_t BasicModel<GameBoard>::hash() const {
+    return board.hash();
+}
+
+template <typename GameBoard>
+const typename BasicModel<GameBoard>::BoardType& BasicModel<GameBoard>::getBoard() const {
+    return board;
+}
+
+// the boards of withBoardSize
+template class BasicModel<Board<3, 3, 3>>;
+template class BasicModel<Board<4, 4, 4>>;
+template class BasicModel<Board<5, 5, 4>>;
+template class BasicModel<Board<6, 6, 4>>;
+template class BasicModel<Board<7, 7, 5>>;
\ No newline at end of file
@@ -1,35 +1,62 @@
 #pragma once
 #include "exceptions.h"
 #include "PlayerType.h"
+#include "Board.h"
+#include "Encoding.h"
 #include <array>
+#include <cstdint>
+
+// the game model on a board of any size, it is built for the boards of withBoardSize (see BoardSizes.h) and Model
+// is the classic 3x3 board with three in a row
+template <typename GameBoard>
+class BasicModel {
+public:
+    using BoardType = GameBoard;
+    using Mask = typename BoardType::Mask;
+    using Grid = std::array<std::array<Cell, BoardType::COLS>, BoardType::ROWS>;
 
-// the game model
-class Model {
 private:
-    std::array<std::array<Cell, 3>, 3> grid; // the grid of the game
+    BoardType board; // the grid of the game
     Status status; // the status of the game
     Player lastPlayed; // contains the last player played
+    std::array<int, BoardType::CELLS> history; // the cells of the played moves in order, followed by the undone ones
+    int moves; // the number of played moves
+    int redoMoves; // the number of played and undone moves that can still be redone
+
+    // put the next player in the given cell and update the status, the redo moves are kept
+    void applyMove(int cell);
 
 public:
     // constructor to initialize the first state of the game
-    Model();
+    BasicModel();
 
     // return the player that should play next either X or O
     Player whoIsNext();
 
-    // play in the grid using the given row and column
+    // play in the grid using the given row and column and update the status from that move
     void play(int row, int column);
 
+    // return the player that should play next without checking if the game is over
+    Player sideToMove() const;
+
+    // try to play in the grid using the given row and column, return why the move was refused instead of throwing
+    MoveResult tryPlay(int row, int column);
+
+    // play the next player in the given cell index without any check, the cell must be open and the game
+    // must not be over, it is meant for search and simulation code
+    void playUnchecked(int cell);
+
     // check of the game is already over
     bool isTheGameOver();
 
     // get the recent grid
-    std::array<std::array<Cell, 3>, 3> getGrid();
+    Grid getGrid();
 
     // get the cell at position [row, column]
     Cell getCell(int row, int column);
 
-    // update the game status if there is already draw or anyone win
+    // update the game status if there is already draw or anyone win, only the lines through the last move
+    // are checked
     void updateStatus();
 
     // check if it's a win case
@@ -44,6 +71,50 @@ public:
     // return the winner player if any
     Player getWinner();
 
-    // undo the last played move using its row and column
+    // undo the last played move using its row and column, the cell must be the one of the last move
     void undo(int row, int column);
-};
\ No newline at end of file
+
+    // undo the last played move and restore the status before it, return false if there is no move to undo
+    bool undo();
+
+    // play again the last undone move, return false if there is no move to redo
+    bool redo();
+
+    // check if there is an undone move that can be redone
+    bool canRedo() const;
+
+    // return the last played move or {-1, -1} if no move is played yet
+    Move lastMove() const;
+
+    // return the number of played moves
+    int moveCount() const;
+
+    // return the mask of the cells occupied by X
+    Mask getXMask() const;
+
+    // return the mask of the cells occupied by O
+    Mask getOMask() const;
+
+    // return the zobrist hash of the position including the side to move
+    uint64_t hash() const;
+
+    // return the base-3 index of the position, from 0 for the empty grid to 3 ^ cells - 1 (19682 for 3x3), only
+    // boards of at most 40 cells have one
+    template <typename B = BoardType>
+    uint64_t encode() const {
+        return Encoding<B>::index(board);
+    }
+
+    // return the position packed in 32 bits (64 bits for more than 16 cells), the X mask in the low half and the O
+    // mask in the high half, only boards of at most 32 cells have one
+    template <typename B = BoardType>
+    typename Encoding<B>::Packed pack() const {
+        return Encoding<B>::pack(board);
+    }
+
+    // return the underlying board
+    const BoardType& getBoard() const;
+};
+
+// the classic game
+using Model = BasicModel<Board<3, 3, 3>>;
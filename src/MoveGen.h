@@ -0,0 +1,97 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+// return the number of set bits of the mask
+inline int popCount(uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(mask);
+#else
+    int count = 0;
+    for (; mask; mask &= mask - 1) {
+        count++;
+    }
+    return count;
+#endif
+}
+
+// return the index of the lowest set bit of the mask, the mask must not be empty
+inline int lowestBit(uint64_t mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(mask);
+#else
+    int index = 0;
+    for (; !(mask & 1); mask >>= 1) {
+        index++;
+    }
+    return index;
+#endif
+}
+
+// return the index of the n-th (from 0) set bit of the mask, n must be less than popCount(mask)
+inline int nthBit(uint64_t mask, int n) {
+    for (int i = 0; i < n; i++) {
+        mask &= mask - 1;
+    }
+
+    return lowestBit(mask);
+}
+
+// MoveList is a fixed capacity list of cell indices that lives on the stack, it is filled from a mask of open
+// cells so generating moves never allocates
+template <int Capacity>
+class MoveList {
+private:
+    std::array<int, Capacity> cells; // the cells of the moves
+    int count; // the number of moves
+
+public:
+    // constructor to initialize an empty list
+    MoveList() : count(0) {}
+
+    // constructor to fill the list with every set bit of the mask from the lowest to the highest
+    explicit MoveList(uint64_t mask) : count(0) {
+        for (; mask; mask &= mask - 1) {
+            cells[count++] = lowestBit(mask);
+        }
+    }
+
+    // add a cell at the end of the list
+    void push(int cell) {
+        cells[count++] = cell;
+    }
+
+    // return the number of moves
+    int size() const {
+        return count;
+    }
+
+    // check if there are no moves
+    bool empty() const {
+        return count == 0;
+    }
+
+    int& operator[](int i) {
+        return cells[i];
+    }
+
+    int operator[](int i) const {
+        return cells[i];
+    }
+
+    int* begin() {
+        return cells.data();
+    }
+
+    int* end() {
+        return cells.data() + count;
+    }
+
+    const int* begin() const {
+        return cells.data();
+    }
+
+    const int* end() const {
+        return cells.data() + count;
+    }
+};
@@ -0,0 +1,132 @@
+#include "OpeningBook.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+// the order of the entries in the file, by key and then from the best score
+static bool entryBefore(const BookEntry& a, const BookEntry& b) {
+    return (a.key != b.key) ? a.key < b.key : a.score > b.score;
+}
+
+OpeningBook::OpeningBook() : data(nullptr), length(0), header(nullptr), entries(nullptr) {}
+
+OpeningBook::~OpeningBook() {
+    close();
+}
+
+bool OpeningBook::open(const string& path) {
+    close();
+
+#if defined(__unix__) || defined(__APPLE__)
+    // the pages are shared with every process that maps the same book
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(file, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(BookHeader))) {
+        ::close(file);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, file, 0);
+    ::close(file);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+
+    data = static_cast<const unsigned char*>(mapped);
+    length = info.st_size;
+#else
+    ifstream file(path, ios::binary);
+    copy.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    if (copy.size() < sizeof(BookHeader)) {
+        copy.clear();
+        return false;
+    }
+
+    data = copy.data();
+    length = copy.size();
+#endif
+
+    // only the header is read, the entries are used where they are
+    header = reinterpret_cast<const BookHeader*>(data);
+    if (memcmp(header->magic, BOOK_MAGIC, sizeof(BOOK_MAGIC)) != 0 || header->version != BOOK_VERSION ||
+        header->count > (length - sizeof(BookHeader)) / sizeof(BookEntry)) {
+        close();
+        return false;
+    }
+
+    entries = reinterpret_cast<const BookEntry*>(data + sizeof(BookHeader));
+    return true;
+}
+
+void OpeningBook::close() {
+#if defined(__unix__) || defined(__APPLE__)
+    if (data != nullptr) {
+        munmap(const_cast<unsigned char*>(data), length);
+    }
+#endif
+
+    copy.clear();
+    data = nullptr;
+    length = 0;
+    header = nullptr;
+    entries = nullptr;
+}
+
+bool OpeningBook::isOpen() const {
+    return header != nullptr;
+}
+
+size_t OpeningBook::size() const {
+    return isOpen() ? header->count : 0;
+}
+
+bool OpeningBook::matches(int rows, int cols, int winLength) const {
+    return isOpen() && header->rows == rows && header->cols == cols && header->winLength == winLength;
+}
+
+const BookEntry* OpeningBook::find(uint64_t key, size_t& count) const {
+    count = 0;
+    if (!isOpen()) {
+        return nullptr;
+    }
+
+    const BookEntry* first = lower_bound(entries, entries + header->count, key,
+                                         [](const BookEntry& entry, uint64_t value) { return entry.key < value; });
+    const BookEntry* last = first;
+    while (last != entries + header->count && last->key == key) {
+        last++;
+    }
+
+    count = last - first;
+    return (count > 0) ? first : nullptr;
+}
+
+bool OpeningBook::write(const string& path, int rows, int cols, int winLength, vector<BookEntry> entries) {
+    sort(entries.begin(), entries.end(), entryBefore);
+
+    BookHeader header = {};
+    memcpy(header.magic, BOOK_MAGIC, sizeof(BOOK_MAGIC));
+    header.version = BOOK_VERSION;
+    header.rows = static_cast<uint8_t>(rows);
+    header.cols = static_cast<uint8_t>(cols);
+    header.winLength = static_cast<uint8_t>(winLength);
+    header.count = entries.size();
+
+    ofstream file(path, ios::binary | ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(BookEntry));
+
+    return static_cast<bool>(file);
+}
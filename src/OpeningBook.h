@@ -0,0 +1,164 @@
+#pragma once
+#include "Board.h"
+#include "MoveGen.h"
+#include "Search.h"
+#include "Symmetry.h"
+#include "TranspositionTable.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// the first bytes of every opening book file
+constexpr char BOOK_MAGIC[8] = { 'T', 'T', 'T', 'B', 'O', 'O', 'K', '\0' };
+
+// the version of the opening book format
+constexpr uint32_t BOOK_VERSION = 1;
+
+// the header at the start of an opening book file
+struct BookHeader {
+    char magic[8]; // BOOK_MAGIC
+    uint32_t version; // BOOK_VERSION
+    uint8_t rows; // the rows of the board of the book
+    uint8_t cols; // the columns of the board of the book
+    uint8_t winLength; // the pieces in a row needed to win
+    uint8_t reserved; // zero
+    uint64_t count; // the number of entries after the header
+};
+
+// one scored move of a book position, the entries are sorted by key and then by score from the best one
+struct BookEntry {
+    uint64_t key; // the zobrist hash of the canonical form of the position (see Symmetry::canonical)
+    int16_t score; // the score of the move for the player to move, as scored by Search
+    int8_t cell; // the cell of the move on the canonical board
+    uint8_t depth; // the depth the move was searched to
+    uint32_t reserved; // zero
+};
+
+static_assert(sizeof(BookHeader) == 24, "the book header has a fixed layout");
+static_assert(sizeof(BookEntry) == 16, "the book entries have a fixed layout");
+
+// OpeningBook is a read-only memory mapping of an opening book file: a BookHeader followed by the sorted
+// BookEntry array in the byte order of the machine that built it. Opening a book only checks its header, the
+// entries are found by binary search right in the mapped pages, so startup doesn't parse the file and the
+// processes that open the same book share its pages
+class OpeningBook {
+private:
+    const unsigned char* data; // the mapped file or nullptr if no book is open
+    size_t length; // the size of the mapped file
+    std::vector<unsigned char> copy; // the file read into memory where mapping isn't available
+    const BookHeader* header; // the header of the open book
+    const BookEntry* entries; // the entries of the open book
+
+public:
+    // constructor to initialize a closed book
+    OpeningBook();
+
+    // destructor to unmap the book
+    ~OpeningBook();
+
+    OpeningBook(const OpeningBook&) = delete;
+    OpeningBook& operator=(const OpeningBook&) = delete;
+
+    // map the book file read-only, return false if it can't be opened or isn't a valid book
+    bool open(const std::string& path);
+
+    // unmap the book
+    void close();
+
+    // check if a book is open
+    bool isOpen() const;
+
+    // return the number of entries of the open book
+    size_t size() const;
+
+    // check if the open book is for boards of the given size
+    bool matches(int rows, int cols, int winLength) const;
+
+    // return the first entry of the position with the given key and set count to its number of entries, or
+    // nullptr if the book doesn't know the position
+    const BookEntry* find(uint64_t key, size_t& count) const;
+
+    // sort the entries and write them as a book for the given board size, return false if the file can't be
+    // written
+    static bool write(const std::string& path, int rows, int cols, int winLength, std::vector<BookEntry> entries);
+
+    // return the best move of the board in the open book as a cell of the board, or -1 if the book is for
+    // another board size or doesn't know the position
+    template <typename BoardType>
+    int bestCell(const BoardType& board, int* score = nullptr) const {
+        if (!matches(BoardType::ROWS, BoardType::COLS, BoardType::WIN_LENGTH)) {
+            return -1;
+        }
+
+        // the book only keeps one of the symmetric positions
+        typename Symmetry<BoardType>::Canonical canonical = Symmetry<BoardType>::canonical(board);
+        size_t count = 0;
+        const BookEntry* entry = find(canonical.board.hash(), count);
+        if (entry == nullptr) {
+            return -1;
+        }
+
+        if (score != nullptr) {
+            *score = entry->score;
+        }
+        return Symmetry<BoardType>::transformCell(entry->cell, Symmetry<BoardType>::inverse(canonical.transform));
+    }
+};
+
+// search every position of at most the given number of plies that isn't over, one of every group of symmetric
+// positions, and return the book entries of their best moves, it is meant to run offline with deep limits
+template <typename BoardType>
+std::vector<BookEntry> buildOpeningBook(int plies, const SearchLimits& limits, TranspositionTable& table) {
+    std::vector<BookEntry> entries;
+    std::vector<BoardType> level = { BoardType() };
+
+    for (int ply = 0; ply <= plies && !level.empty(); ply++) {
+        std::vector<BoardType> next;
+
+        for (const BoardType& position : level) {
+            BoardType board = position;
+            Search<BoardType> search(table);
+            table.newSearch();
+
+            typename Search<BoardType>::Result best = search.iterativeDeepening(
+                board, BoardType::CELLS - board.moveCount(), Symmetry<BoardType>::uniqueMoves(board), limits);
+            if (best.cell < 0) {
+                continue;
+            }
+
+            BookEntry entry = {};
+            entry.key = board.hash();
+            entry.score = static_cast<int16_t>(best.score);
+            entry.cell = static_cast<int8_t>(best.cell);
+            entry.depth = static_cast<uint8_t>(search.getCompletedDepth());
+            entries.push_back(entry);
+
+            // the canonical children of the position that aren't over are the next level
+            if (ply == plies) {
+                continue;
+            }
+            Player side = board.sideToMove();
+            for (typename BoardType::Mask open = Symmetry<BoardType>::uniqueMoves(board); open; open &= open - 1) {
+                int cell = lowestBit(open);
+                BoardType child = board;
+                child.place(cell, side);
+
+                if (!child.isWinAt(cell, side) && !child.isFull()) {
+                    next.push_back(Symmetry<BoardType>::canonical(child).board);
+                }
+            }
+        }
+
+        // a position reached by two move orders is searched once
+        std::sort(next.begin(), next.end(), [](const BoardType& a, const BoardType& b) {
+            return (a.getXMask() != b.getXMask()) ? a.getXMask() < b.getXMask() : a.getOMask() < b.getOMask();
+        });
+        next.erase(std::unique(next.begin(), next.end()), next.end());
+        level = std::move(next);
+    }
+
+    return entries;
+}
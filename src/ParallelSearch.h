@@ -0,0 +1,205 @@
+#pragma once
+#include "Search.h"
+#include "ThreadPool.h"
+#include "TranspositionTable.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <future>
+#include <vector>
+
+// ParallelSearch runs Search on the workers of a thread pool, it has two modes:
+// - root split for small boards: every root move of a depth is searched with the whole window by its own task,
+//   the best score wins and equal scores keep the lower cell so the result doesn't depend on the timing
+// - Lazy SMP for large boards: the helpers run the same iterative deepening from staggered depths with their own
+//   move order and share what they find through the lock-free transposition table, the move of the main search
+//   is played
+template <typename BoardType>
+class ParallelSearch {
+public:
+    using Mask = typename BoardType::Mask;
+    using Result = typename Search<BoardType>::Result;
+
+    // the biggest board searched by root split, the root of a larger one has too many moves for every one of
+    // them to get a full window
+    static constexpr int ROOT_SPLIT_CELLS = 16;
+
+    // the number of depths the Lazy SMP helpers start from, a helper that starts deeper than that spends more on
+    // its first depths without the table filled by the shallower searches than it gains from the spread
+    static constexpr int HELPER_DEPTHS = 3;
+
+private:
+    TranspositionTable& table; // the searched positions, shared by every thread
+    ThreadPool& pool; // the workers of the search
+    std::atomic<bool> stop; // set to stop the helpers
+    const std::atomic<bool>* cancel; // set by another thread to stop the whole search or nullptr
+    SearchCounters counters; // the counters of every thread of the last search
+    int completedDepth; // the deepest depth the last search completed
+
+    // the result of searching one root move
+    struct MoveScore {
+        int score; // the score of the move for the player to move
+        bool stopped; // if the search of the move ran out of its budget
+        SearchCounters counters; // the counters of the search of the move
+    };
+
+    // search every root move of a depth on its own task and keep the best one of the last completed depth
+    Result rootSplit(const BoardType& board, int maxDepth, Mask rootMoves, const SearchLimits& limits) {
+        Result best = { -1, -INFINITE_SCORE };
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        MoveList<BoardType::CELLS> moves(rootMoves);
+
+        for (int depth = 1; depth <= maxDepth && !moves.empty(); depth++) {
+            // the node budget left is split between the root moves
+            SearchLimits moveLimits = limits;
+            if (limits.nodes != 0) {
+                uint64_t left = (limits.nodes > counters.nodes) ? limits.nodes - counters.nodes : 0;
+                moveLimits.nodes = std::max<uint64_t>(left / moves.size(), 1);
+            }
+
+            std::vector<std::future<MoveScore>> futures;
+            for (int cell : moves) {
+                futures.push_back(pool.submit([this, board, cell, depth, moveLimits, start]() {
+                    BoardType copy = board;
+                    Search<BoardType> search(table);
+
+                    search.setStopFlag(cancel);
+                    search.setLimits(moveLimits, start);
+                    search.setLimitsActive(depth > 1);
+                    int score = search.searchMove(copy, cell, depth, -INFINITE_SCORE, INFINITE_SCORE);
+
+                    return MoveScore{ score, search.wasStopped(), search.getCounters() };
+                }));
+            }
+
+            // the futures are read in cell order so equal scores keep the lower cell
+            Result result = { -1, -INFINITE_SCORE };
+            bool stopped = false;
+            for (int i = 0; i < moves.size(); i++) {
+                MoveScore moveScore = futures[i].get();
+
+                counters.add(moveScore.counters);
+                stopped = stopped || moveScore.stopped;
+                if (moveScore.score > result.score) {
+                    result = Result{ moves[i], moveScore.score };
+                }
+            }
+
+            if (stopped) {
+                break;
+            }
+
+            best = result;
+            completedDepth = depth;
+            if (table.store(board.hash(), best.score, depth, Exact, best.cell)) {
+                counters.tableStores++;
+            }
+
+            if ((best.score > WIN_THRESHOLD || best.score < -WIN_THRESHOLD) && WIN_SCORE - abs(best.score) <= depth) {
+                break;
+            }
+        }
+
+        return best;
+    }
+
+    // the result of the main thread of Lazy SMP
+    struct MainResult {
+        Result best; // the move that is played
+        SearchCounters counters; // the counters of the main search
+        int completedDepth; // the deepest depth the main search completed
+    };
+
+    // run the iterative deepening on every worker, the first one is the main search whose move is played and the
+    // others are helpers, the calling thread only waits so no worker sits idle
+    Result lazySmp(const BoardType& board, int maxDepth, Mask rootMoves, const SearchLimits& limits) {
+        int threads = std::max(pool.size(), 1);
+
+        // every thread gets its part of the node budget
+        SearchLimits threadLimits = limits;
+        if (limits.nodes != 0) {
+            threadLimits.nodes = std::max<uint64_t>(limits.nodes / threads, 1);
+        }
+
+        std::future<MainResult> main = pool.submit([this, board, maxDepth, rootMoves, threadLimits]() {
+            BoardType copy = board;
+            Search<BoardType> search(table);
+
+            search.setStopFlag(cancel);
+            Result best = search.iterativeDeepening(copy, maxDepth, rootMoves, threadLimits);
+
+            return MainResult{ best, search.getCounters(), search.getCompletedDepth() };
+        });
+
+        std::vector<std::future<SearchCounters>> helpers;
+        for (int i = 1; i < threads; i++) {
+            // the helpers start up to HELPER_DEPTHS - 1 depths deeper than the main search and every one of them
+            // orders the moves that are worth the same its own way, so no two threads search the same tree
+            int startDepth = std::min(1 + i % HELPER_DEPTHS, maxDepth);
+
+            helpers.push_back(pool.submit([this, board, maxDepth, rootMoves, threadLimits, startDepth, i]() {
+                BoardType copy = board;
+                Search<BoardType> search(table);
+
+                search.setStopFlag(&stop);
+                search.perturbOrder(i);
+                search.iterativeDeepening(copy, maxDepth, rootMoves, threadLimits, startDepth);
+
+                return search.getCounters();
+            }));
+        }
+
+        MainResult result = main.get();
+
+        // the helpers only fill the table, they are stopped as soon as the move is known
+        stop = true;
+        counters.add(result.counters);
+        for (std::future<SearchCounters>& helper : helpers) {
+            counters.add(helper.get());
+        }
+        completedDepth = result.completedDepth;
+
+        return result.best;
+    }
+
+public:
+    // constructor to initialize a search that uses the given transposition table and thread pool
+    ParallelSearch(TranspositionTable& transpositionTable, ThreadPool& threadPool)
+        : table(transpositionTable), pool(threadPool), stop(false), cancel(nullptr), completedDepth(0) {}
+
+    // stop the search as soon as the given flag is set by another thread, nullptr removes the flag
+    void setStopFlag(const std::atomic<bool>* flag) {
+        cancel = flag;
+    }
+
+    // return the number of positions visited by every thread of the last search
+    uint64_t getNodes() const {
+        return counters.nodes;
+    }
+
+    // return the counters of every thread of the last search
+    SearchCounters getCounters() const {
+        return counters;
+    }
+
+    // return the deepest depth the last search completed
+    int getCompletedDepth() const {
+        return completedDepth;
+    }
+
+    // search the given root moves one depth more at a time up to maxDepth until the budget runs out and return
+    // the best move, root split is used for boards of at most ROOT_SPLIT_CELLS cells and Lazy SMP otherwise
+    Result iterativeDeepening(const BoardType& board, int maxDepth, Mask rootMoves, const SearchLimits& limits) {
+        stop = false;
+        counters = SearchCounters();
+        completedDepth = 0;
+
+        if (BoardType::CELLS <= ROOT_SPLIT_CELLS) {
+            return rootSplit(board, maxDepth, rootMoves, limits);
+        }
+
+        return lazySmp(board, maxDepth, rootMoves, limits);
+    }
+};
@@ -1,7 +1,35 @@
 #pragma once
+#include "TranspositionTable.h"
+#include "ThreadPool.h"
+#include "Random.h"
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
-class Model;
+template <int Rows, int Cols, int K>
+class Board;
+
+template <typename GameBoard>
+class BasicModel;
+
+template <typename BoardType>
+class Encoding;
+
+template <typename BoardType>
+class Mcts;
+
+class OpeningBook;
+
+template <typename BoardType>
+class ProofSearch;
 
 // Player is one of X and O, it is used for knowing which turn is this
 enum Player {
@@ -25,11 +53,22 @@ enum Cell {
     Open
 };
 
-// Difficulty is one of Easy, Normal, Hard to identify the difficulty of the AI
+// MoveResult is one of Played, OutOfBounds, CellTaken and GameOver, it is the result of trying to play a move
+// without exceptions, Played means the move is done and the others say why it was refused
+enum MoveResult {
+    Played,
+    OutOfBounds,
+    CellTaken,
+    GameOver
+};
+
+// Difficulty is one of Easy, Normal, Hard and MonteCarlo to identify the difficulty of the AI, MonteCarlo
+// plays by Monte Carlo tree search for boards too big for Hard to search to the end
 enum Difficulty {
     Easy,
     Normal,
-    Hard
+    Hard,
+    MonteCarlo
 };
 
 // Move is a row and column of a specific move
@@ -38,35 +77,156 @@ struct Move {
     int column;
 };
 
-// PlayerType is one of Human and AI, it's used to know the type of the player either Human or AI
-class PlayerType {
+// Evaluation is the best cell of a position and its score for the player to move, a win found p plies later
+// scores WIN_SCORE - p, a loss the negation of that and a draw 0
+struct Evaluation {
+    int cell; // the best cell or -1 if the game is over or the position is illegal
+    int score; // the score of the best cell
+    bool legal = true; // if a game can reach the position, an illegal one has no cell and a score of 0
+};
+
+// SearchStats is what the moves of an ai cost, for its last move or added up over many moves and games, the
+// cutoffs and the deepest ply are only counted when the library is built with TICTACTOE_SEARCH_STATS
+struct SearchStats {
+    uint64_t moves = 0; // the number of moves played
+    uint64_t nodes = 0; // the visited positions (playouts for MonteCarlo, expanded positions for the solver)
+    uint64_t cutoffs = 0; // the moves that failed high and cut their siblings
+    uint64_t tableHits = 0; // the transposition table probes that found their position
+    uint64_t tableStores = 0; // the positions stored in the transposition table
+    int maxDepth = 0; // the deepest ply a search reached
+    double seconds = 0.0; // the wall-clock time spent choosing the moves
+
+    // add the stats of other moves
+    void add(const SearchStats& other) {
+        moves += other.moves;
+        nodes += other.nodes;
+        cutoffs += other.cutoffs;
+        tableHits += other.tableHits;
+        tableStores += other.tableStores;
+        maxDepth = (other.maxDepth > maxDepth) ? other.maxDepth : maxDepth;
+        seconds += other.seconds;
+    }
+
+    // return the visited positions per second
+    double nodesPerSecond() const {
+        return (seconds > 0.0) ? nodes / seconds : 0.0;
+    }
+
+    // return the part of the visited positions that had a cutoff
+    double cutoffRate() const {
+        return (nodes > 0) ? static_cast<double>(cutoffs) / nodes : 0.0;
+    }
+};
+
+// CancelToken is shared between an ai move running on a worker thread and the code that may cancel it, every
+// copy refers to the same flag and the search stops at its next check once it is cancelled
+class CancelToken {
+private:
+    std::shared_ptr<std::atomic<bool>> flag; // the flag checked by the search
+
+public:
+    // constructor to initialize a token that isn't cancelled
+    CancelToken() : flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+    // cancel the move, it can be called from any thread
+    void cancel() const {
+        flag->store(true);
+    }
+
+    // check if the move is cancelled
+    bool isCancelled() const {
+        return flag->load();
+    }
+
+    // return the flag the search checks
+    const std::atomic<bool>* get() const {
+        return flag.get();
+    }
+};
+
+// PlayerType is one of Human and AI, it's used to know the type of the player either Human or AI, the players
+// of every board size are built for the boards of withBoardSize (see BoardSizes.h) and PlayerType, Human and AI
+// play the classic 3x3 game
+template <typename GameBoard>
+class BasicPlayerType {
 public:
     // virtual function to make sure every derived class can play properly
-    virtual void play(Player player, Model& game, int row, int col) = 0;
-    virtual ~PlayerType() = default;
+    virtual void play(Player player, BasicModel<GameBoard>& game, int row, int col) = 0;
+    virtual ~BasicPlayerType() = default;
     virtual bool isHuman() = 0;
 };
 
 // Human is a PlayerType that indicates that this player is a human
-class Human : public PlayerType {
+template <typename GameBoard>
+class BasicHuman : public BasicPlayerType<GameBoard> {
 public:
     // play as a human
-    void play(Player player, Model& game, int row, int col);
+    void play(Player player, BasicModel<GameBoard>& game, int row, int col);
 
     // check if the player is human (return true because we are in Human (Daahhh!))
     bool isHuman();
 };
 
 // AI is a playerType that indictates that this player is AI
-class AI : public PlayerType {
+template <typename GameBoard>
+class BasicAI : public BasicPlayerType<GameBoard> {
+public:
+    using Model = BasicModel<GameBoard>; // the game the ai plays
+
 private: 
     Difficulty difficulty; // the difficulty of the AI
+    bool useSolvedTable; // if the hard ai reads its moves from the solved game instead of searching
+    TranspositionTable table; // the searched positions, kept between moves
+    int64_t timeLimit; // the wall-clock milliseconds of a move or 0 for no limit
+    std::chrono::steady_clock::time_point moveStart; // the start of the current move, timeLimit counts from it
+    uint64_t nodeLimit; // the positions a search can visit or 0 for no limit
+    int threads; // the number of threads of a search, 1 searches on the calling thread only
+    uint64_t seed; // the seed of the random choices of the ai
+    Random random; // the random generator of the easy and normal moves
+    std::unique_ptr<ThreadPool> pool; // the workers of a parallel search, started on the first one
+    std::unique_ptr<Mcts<GameBoard>> mcts; // the tree of the monte carlo ai, kept between moves
+    std::unique_ptr<OpeningBook> book; // the mapped opening book or nullptr
+    uint64_t proofNodes; // the positions the solver can expand before the hard search or 0 for no solver
+    std::unique_ptr<ProofSearch<GameBoard>> solver; // the proof-number solver, kept between moves
+    std::thread ponderThread; // searches the replies to the opponent moves while the opponent thinks
+    std::atomic<bool> ponderStop; // set to stop the pondering search
+    std::atomic<bool> pondering; // if the pondering thread is still searching
+    mutable std::mutex ponderMutex; // protects the pondered replies
+    std::unordered_map<uint64_t, int> ponderedReplies; // the best cell of every pondered position by its hash
+    uint64_t ponderHits; // the number of moves played from the pondered replies
+    const std::atomic<bool>* cancelFlag; // the flag of the cancel token of the running move or nullptr
+    SearchStats lastStats; // the cost of the last move
+    SearchStats totalStats; // the cost of every move since the stats were reset
+
+    // search the best cell of the board with the limits of the ai on the calling thread, return -1 if the stop
+    // flag stopped the search before it ended
+    int searchBestCell(const GameBoard& board, const std::atomic<bool>* stop);
+
+    // search the reply to every open cell of the board, the predicted one first, until stopped
+    void ponderReplies(const GameBoard& board);
+
+    // return the workers of the parallel search with the current number of threads
+    ThreadPool& getPool();
+
+    // play the best move from the solved game table, return false if the position isn't in the table or the
+    // board isn't 3x3
+    bool playSolvedMove(Model& game);
+
+    // play the best move of the opening book, return false if there is no book or it doesn't know the position
+    bool playBookMove(Model& game);
 
-    // play the best move available
-    void playBestMove(Model& game, Player aiPlayer);
+    // return the milliseconds left of the time limit of the current move, at least 1, or 0 for no limit
+    int64_t remainingTime() const;
 
-    // minimax algorithm
-    int minimax(Model& game, int depth, bool maximizingPlayer, int alpha, int beta, Player player);
+    // play the winning or drawing move if the solver proves one within its budget (half of the time of the
+    // move at most), return false otherwise
+    bool playProvenMove(Model& game);
+
+    // play the best move available by searching deeper and deeper until the end of the game or the limits
+    void playBestMove(Model& game);
+
+    // play the most visited move of a monte carlo tree search
+    void playMonteCarloMove(Model& game);
 
     // play as an easy ai agent
     void playEasyMove(Model& game);
@@ -74,12 +234,12 @@ private:
     // play as a medium ai agent
     void playNormalMove(Model& game, Player aiPlayer);
 
-    // check if the opponent won
-    bool isOpponentWin(std::array<std::array<Cell, 3>, 3> grid, Cell winner);
-
 public:
     // initialize the AI
-    AI(Difficulty diff);
+    BasicAI(Difficulty diff);
+
+    // destructor to stop pondering and free the monte carlo tree
+    ~BasicAI();
 
     // play as AI
     void play(Player player, Model& game, int row, int col);
@@ -89,4 +249,87 @@ public:
 
     // return the ai model difficulty
     Difficulty getDifficulty();
-};
\ No newline at end of file
+
+    // choose if the hard ai reads the solved game table of the 3x3 board (the default) or searches
+    void setUseSolvedTable(bool use);
+
+    // change the memory of the transposition table to at most the given number of megabytes
+    void setTableSize(size_t megabytes);
+
+    // limit every move to the given wall-clock milliseconds, the solver and the search share them and the move
+    // of the last completed depth is played when the time runs out, 0 removes the limit
+    void setTimeLimit(int64_t milliseconds);
+
+    // limit every search to the given number of positions (playouts for MonteCarlo), 0 removes the limit
+    void setNodeLimit(uint64_t nodes);
+
+    // search with the given number of threads, 1 (the default) keeps the search on the calling thread so the
+    // moves are deterministic
+    void setThreads(int count);
+
+    // return the number of threads of a search
+    int getThreads() const;
+
+    // return the cell the ai plays in the position or -1 if the token was cancelled first, the move is played
+    // on a copy so it can run on a worker thread while the owner keeps the model, the ai must not be used by
+    // another thread until it returns
+    int chooseMove(const Model& game, const CancelToken& token);
+
+    // start searching the replies to every move the opponent can play from the position on a background
+    // thread, the next move is played at once if it was pondered, only the hard ai ponders and it skips the replies
+    // the solved 3x3 table or the opening book answer without searching
+    void ponder(const Model& game);
+
+    // stop the pondering thread and wait for it, the replies found so far are kept
+    void stopPondering();
+
+    // check if the pondering thread is still searching
+    bool isPondering() const;
+
+    // return the number of moves played from the pondered replies
+    uint64_t getPonderHits() const;
+
+    // check if the reply to the position was already found by pondering, the move is then played at once
+    bool hasPonderedReply(const Model& game) const;
+
+    // restart the random choices of the ai (easy moves and monte carlo playouts) from the given seed, the
+    // same seed gives the same games, the default seed is 0
+    void setSeed(uint64_t value);
+
+    // return the seed of the random choices of the ai
+    uint64_t getSeed() const;
+
+    // map the opening book file read-only, the hard and monte carlo ai play its moves before searching, return
+    // false if the file isn't a book or is a book of another board size (the ai keeps no book then)
+    bool loadOpeningBook(const std::string& path);
+
+    // try to prove the position with the proof-number solver with the given budget of expanded positions
+    // before every hard search, a proven win or draw is played without searching, 0 (the default) doesn't
+    void setProofNodeLimit(uint64_t nodes);
+
+    // return the best move and value of every packed position (see BasicModel::pack) in the same order without
+    // playing, the positions are searched with the limits, threads and table of the ai, only boards of at most 32
+    // cells have a packed form
+    template <typename B = GameBoard>
+    std::vector<Evaluation> evaluate(const std::vector<typename Encoding<B>::Packed>& positions);
+
+    // return the cost of the last move played by play or chooseMove
+    const SearchStats& getLastStats() const;
+
+    // return the cost of every move since the ai was created or the stats were reset
+    const SearchStats& getTotalStats() const;
+
+    // start counting the total stats again
+    void resetStats();
+
+    // return the number of playouts per second of the last monte carlo search
+    double getPlayoutsPerSecond() const;
+
+    // return the transposition table of the search and its counters
+    const TranspositionTable& getTranspositionTable() const;
+};
+
+// the players of the classic game
+using PlayerType = BasicPlayerType<Board<3, 3, 3>>;
+using Human = BasicHuman<Board<3, 3, 3>>;
+using AI = BasicAI<Board<3, 3, 3>>;
\ No newline at end of file
@@ -0,0 +1,217 @@
+#pragma once
+#include "Board.h"
+#include "MoveGen.h"
+#include "Random.h"
+#include <array>
+#include <cstdint>
+
+// LINE_CELLS of PlayoutBatch, the cell indices of every winning line
+template <typename Mask, int LineCount, int K>
+constexpr std::array<std::array<int, K>, LineCount> makeLineCells(const std::array<Mask, LineCount>& lines) {
+    std::array<std::array<int, K>, LineCount> cells{};
+
+    for (int line = 0; line < LineCount; line++) {
+        int count = 0;
+        for (int cell = 0; count < K; cell++) {
+            if (lines[line] & (Mask(1) << cell)) {
+                cells[line][count++] = cell;
+            }
+        }
+    }
+
+    return cells;
+}
+
+// PlayoutBatch plays up to 64 random games from the same position at once, one game in every bit (lane) of a
+// 64-bit word. The games move together one ply at a time and everything is bit-sliced: the pieces are a lane
+// mask for every cell, so a winning line is tested for all the games with K ANDs, and the move of every lane
+// is picked at once from a random index held in bit planes. A game that is over leaves the active lanes
+template <typename BoardType>
+class PlayoutBatch {
+public:
+    using Mask = typename BoardType::Mask;
+
+    // the number of games of a batch
+    static constexpr int LANES = 64;
+
+    // the cells of every winning line
+    static constexpr std::array<std::array<int, BoardType::WIN_LENGTH>, BoardType::LINE_COUNT> LINE_CELLS =
+        makeLineCells<Mask, BoardType::LINE_COUNT, BoardType::WIN_LENGTH>(BoardType::LINES);
+
+    // the lanes of the games of a batch by their result
+    struct Outcome {
+        uint64_t xWins; // the games won by X
+        uint64_t oWins; // the games won by O
+        uint64_t draws; // the games with a full grid and no winner
+    };
+
+    // the number of games by their result
+    struct Totals {
+        uint64_t xWins; // the number of games won by X
+        uint64_t oWins; // the number of games won by O
+        uint64_t draws; // the number of drawn games
+    };
+
+private:
+    Random random; // the random generator of the moves, one jump away from the one seeded with the same seed
+
+    // return the lanes of the active games in which the given cell slices complete a winning line
+    static uint64_t winningLanes(const std::array<uint64_t, BoardType::CELLS>& slices, uint64_t active) {
+        uint64_t won = 0;
+
+        for (const auto& line : LINE_CELLS) {
+            uint64_t lanes = active;
+            for (int cell : line) {
+                lanes &= slices[cell];
+            }
+            won |= lanes;
+        }
+
+        return won;
+    }
+
+    // the number of bit planes of a random index below the given number of open cells
+    static constexpr int indexBits(int open) {
+        int bits = 1;
+        while ((1 << bits) < open) {
+            bits++;
+        }
+
+        return bits;
+    }
+
+    // the bit planes of a random index below the number of open cells
+    using Index = std::array<uint64_t, indexBits(BoardType::CELLS)>;
+
+    // return the lanes of the given ones whose index is at least the bound
+    static uint64_t atLeast(const Index& index, int bits, int bound, uint64_t lanes) {
+        if (bound >= (1 << bits)) {
+            return 0;
+        }
+
+        uint64_t greater = 0;
+        uint64_t equal = lanes;
+
+        for (int bit = bits - 1; bit >= 0; bit--) {
+            if (bound & (1 << bit)) {
+                equal &= index[bit];
+            }
+            else {
+                greater |= equal & index[bit];
+                equal &= ~index[bit];
+            }
+        }
+
+        return greater | equal;
+    }
+
+    // fill the index of the given lanes with a random number below the number of open cells, the lanes past
+    // it draw again so every cell is as likely (more than half of the draws pass)
+    void drawIndex(Index& index, int bits, int open, uint64_t lanes) {
+        for (int bit = 0; bit < bits; bit++) {
+            index[bit] = random.next();
+        }
+
+        for (uint64_t again = atLeast(index, bits, open, lanes); again; again = atLeast(index, bits, open, again)) {
+            for (int bit = 0; bit < bits; bit++) {
+                index[bit] = (index[bit] & ~again) | (random.next() & again);
+            }
+        }
+    }
+
+    // return the lanes of the given ones whose index is zero
+    static uint64_t zeroLanes(const Index& index, int bits, uint64_t lanes) {
+        for (int bit = 0; bit < bits; bit++) {
+            lanes &= ~index[bit];
+        }
+
+        return lanes;
+    }
+
+    // take one from the index of the given lanes
+    static void decrement(Index& index, int bits, uint64_t lanes) {
+        uint64_t borrow = lanes;
+
+        for (int bit = 0; bit < bits && borrow; bit++) {
+            uint64_t plane = index[bit];
+            index[bit] = plane ^ borrow;
+            borrow &= ~plane;
+        }
+    }
+
+public:
+    // constructor to initialize the random generator from the given seed
+    explicit PlayoutBatch(uint64_t seed = 0) : random(Random::stream(seed, 1)) {}
+
+    // restart the random generator from the given seed
+    void setSeed(uint64_t seed) {
+        random = Random::stream(seed, 1);
+    }
+
+    // play the given number of random games (at most LANES) from the position and return their results, game i
+    // is the lane 1 << i, the position must not be over
+    Outcome run(const BoardType& board, int games = LANES) {
+        uint64_t lanes = (games >= LANES) ? ~uint64_t(0) : ((uint64_t(1) << games) - 1);
+        Outcome outcome = { 0, 0, 0 };
+
+        // the pieces of every game by cell
+        std::array<std::array<uint64_t, BoardType::CELLS>, 2> slices;
+        for (int cell = 0; cell < BoardType::CELLS; cell++) {
+            slices[X][cell] = (board.getXMask() & BoardType::bit(cell)) ? lanes : 0;
+            slices[O][cell] = (board.getOMask() & BoardType::bit(cell)) ? lanes : 0;
+        }
+
+        // every game has the same number of pieces of each side and of open cells since they move together
+        std::array<int, 2> counts = { popCount(board.getXMask()), popCount(board.getOMask()) };
+        int open = BoardType::CELLS - board.moveCount();
+        Player side = board.sideToMove();
+        uint64_t active = lanes;
+        Index index{};
+
+        while (active && open > 0) {
+            // every lane plays its open cell number index, counting its open cells in order
+            int bits = indexBits(open);
+            drawIndex(index, bits, open, active);
+
+            uint64_t waiting = active;
+            for (int cell = 0; cell < BoardType::CELLS && waiting; cell++) {
+                uint64_t empty = waiting & ~(slices[X][cell] | slices[O][cell]);
+                uint64_t picked = zeroLanes(index, bits, empty);
+
+                slices[side][cell] |= picked;
+                waiting &= ~picked;
+                decrement(index, bits, empty & ~picked);
+            }
+
+            // a side can't have a line before it has K pieces
+            if (++counts[side] >= BoardType::WIN_LENGTH) {
+                uint64_t won = winningLanes(slices[side], active);
+                ((side == X) ? outcome.xWins : outcome.oWins) |= won;
+                active &= ~won;
+            }
+
+            open--;
+            side = (side == X) ? O : X;
+        }
+
+        outcome.draws = active;
+        return outcome;
+    }
+
+    // play the given number of random games from the position in batches of LANES and count their results
+    Totals count(const BoardType& board, uint64_t games) {
+        Totals totals = { 0, 0, 0 };
+
+        while (games > 0) {
+            int batch = (games >= LANES) ? LANES : static_cast<int>(games);
+            Outcome outcome = run(board, batch);
+
+            totals.xWins += popCount(outcome.xWins);
+            totals.oWins += popCount(outcome.oWins);
+            totals.draws += popCount(outcome.draws);
+            games -= batch;
+        }
+
+        return totals;
+    }
+};
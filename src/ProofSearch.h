@@ -0,0 +1,336 @@
+#pragma once
+#include "Board.h"
+#include "MoveGen.h"
+#include "Search.h"
+#include "Threats.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// ProofResult is one of Unproven, ProvenWin, ProvenDraw and ProvenLoss, it is the value of a position for the
+// player to move found by ProofSearch, Unproven means the solver ran out of its budget first
+enum ProofResult {
+    Unproven,
+    ProvenWin,
+    ProvenDraw,
+    ProvenLoss
+};
+
+// ProofSearch is a depth-first proof-number (df-pn) solver for any board size, it proves the value of a
+// position instead of scoring it: a proof number is the least number of positions that still have to be
+// proven to prove the goal and a disproof number the least number to disprove it, the solver always expands
+// the most proving position and only goes deeper while the numbers stay under the thresholds of its parent
+//
+// a position is solved by two proofs: first if the player to move wins, then if the opponent does, when both
+// are disproven it is a draw. The numbers are kept in a table of a fixed number of slots chosen from the memory
+// budget, a position lost from the table is expanded again so the memory bound never changes the result
+template <typename BoardType>
+class ProofSearch {
+public:
+    using Mask = typename BoardType::Mask;
+
+    // the number of a goal that can't be reached, it is also the most a sum of numbers can grow to
+    static constexpr uint32_t INFINITE_PROOF = 0x7FFFFFFF;
+
+    // the result of a solve
+    struct Result {
+        ProofResult result; // the value of the position for the player to move
+        int cell; // the winning or drawing cell, any legal cell of a lost position or -1 if unproven or over
+        uint64_t nodes; // the number of expanded positions of both proofs
+        uint32_t proof; // the proof number of the last proof at the root
+        uint32_t disproof; // the disproof number of the last proof at the root
+    };
+
+private:
+    // the numbers of a position, phi is the number of the goal of the player to move and delta the number of
+    // the goal of the opponent: the proof and disproof numbers for the attacker and the opposite for the
+    // defender
+    struct Numbers {
+        uint32_t phi;
+        uint32_t delta;
+    };
+
+    // one slot of the table
+    struct Slot {
+        uint64_t key; // the zobrist hash of the position xor the salt of the attacker, 0 for an empty slot
+        Numbers numbers; // the numbers of the position
+    };
+
+    // xor-ed into the keys of the proof of O so the two proofs don't read the numbers of each other
+    static constexpr uint64_t O_SALT = 0x5DEECE66DULL << 20;
+
+    std::unique_ptr<Slot[]> slots; // the table of the numbers of the expanded positions
+    size_t slotCount; // the number of slots, a power of two
+    Player attacker; // the player whose win the current proof is about
+    uint64_t nodes; // the number of expanded positions
+    std::chrono::steady_clock::time_point deadline; // the time the solver has to stop at
+    bool hasDeadline; // if the solver has a time limit
+    uint64_t nodeLimit; // the number of positions the solver can expand or 0 for no node limit
+    bool stopped; // if the solver ran out of its budget
+    const std::atomic<bool>* stopFlag; // set by another thread to stop the solver or nullptr
+
+    // add two numbers without going over INFINITE_PROOF
+    static uint32_t add(uint32_t a, uint32_t b) {
+        return static_cast<uint32_t>(std::min<uint64_t>(uint64_t(a) + b, INFINITE_PROOF));
+    }
+
+    // check if the solver ran out of its budget, the clock is only read every 1024 positions
+    bool shouldStop() {
+        if (stopped) {
+            return true;
+        }
+        if (stopFlag != nullptr && stopFlag->load(std::memory_order_relaxed)) {
+            stopped = true;
+        }
+        else if (nodeLimit != 0 && nodes >= nodeLimit) {
+            stopped = true;
+        }
+        else if (hasDeadline && (nodes & 1023) == 0 && std::chrono::steady_clock::now() >= deadline) {
+            stopped = true;
+        }
+
+        return stopped;
+    }
+
+    // return the table key of the position in the current proof
+    uint64_t keyOf(const BoardType& board) const {
+        // the lowest bit is set so no key is 0, the key of the empty slots
+        return (board.hash() ^ ((attacker == O) ? O_SALT : 0)) | 1;
+    }
+
+    // return the slot of the position
+    Slot& slotOf(uint64_t key) const {
+        return slots[key & (slotCount - 1)];
+    }
+
+    // set the numbers of a position that is decided without expanding it and return true, or return false:
+    // the opponent has just won, the grid is full, the player to move wins at once or the opponent has two
+    // threats the player can't both block, only the lines of the last cell are checked for the win if it's known
+    bool isDecided(const BoardType& board, Player side, int lastCell, Numbers& numbers) const {
+        Player other = (side == X) ? O : X;
+        bool won = false;
+        bool lost = false;
+
+        if ((lastCell >= 0) ? board.isWinAt(lastCell, other) : board.hasWin(other)) {
+            lost = true;
+        }
+        else if (board.isFull()) {
+            // a draw is a loss for the attacker and a win for the defender
+            won = (side != attacker);
+            lost = (side == attacker);
+        }
+        else if (Threats<BoardType>::winningMoves(board, side)) {
+            won = true;
+        }
+        else {
+            Mask threats = Threats<BoardType>::winningMoves(board, other);
+            lost = (threats & (threats - 1)) != 0;
+        }
+
+        if (won) {
+            numbers = Numbers{ 0, INFINITE_PROOF };
+        }
+        else if (lost) {
+            numbers = Numbers{ INFINITE_PROOF, 0 };
+        }
+
+        return won || lost;
+    }
+
+    // return the moves worth trying: the winning cells, else the cell that blocks a threat of the opponent,
+    // else every open cell
+    static Mask candidateMoves(const BoardType& board, Player side) {
+        Mask wins = Threats<BoardType>::winningMoves(board, side);
+        Mask blocks = Threats<BoardType>::blockingMoves(board, side);
+        return wins ? wins : blocks ? blocks : board.empty();
+    }
+
+    // return the numbers of the position reached by playing the last cell from the table, deciding it first if
+    // it's over, or 1 and 1 for a position that was never expanded
+    Numbers numbersOf(const BoardType& board, Player side, int lastCell) const {
+        Numbers numbers = { 1, 1 };
+
+        if (!isDecided(board, side, lastCell, numbers)) {
+            uint64_t key = keyOf(board);
+            const Slot& slot = slotOf(key);
+            if (slot.key == key) {
+                numbers = slot.numbers;
+            }
+        }
+
+        return numbers;
+    }
+
+    // store the numbers of the position, the slot is always replaced
+    void store(const BoardType& board, Numbers numbers) {
+        uint64_t key = keyOf(board);
+        Slot& slot = slotOf(key);
+
+        slot.key = key;
+        slot.numbers = numbers;
+    }
+
+    // expand the position until its phi reaches phiLimit or its delta reaches deltaLimit (one of them is
+    // reached when the position is solved) or the budget runs out
+    void expand(BoardType& board, Player side, int lastCell, uint32_t phiLimit, uint32_t deltaLimit) {
+        // a decided position doesn't need the table, numbersOf decides it again
+        Numbers numbers;
+        if (isDecided(board, side, lastCell, numbers)) {
+            return;
+        }
+
+        nodes++;
+        Player other = (side == X) ? O : X;
+        MoveList<BoardType::CELLS> moves(candidateMoves(board, side));
+
+        while (!shouldStop()) {
+            // phi is the smallest delta of a child (one child is enough) and delta the sum of their phi
+            numbers = Numbers{ INFINITE_PROOF, 0 };
+            int best = -1;
+            uint32_t bestPhi = 0;
+            uint32_t secondDelta = INFINITE_PROOF;
+
+            for (int cell : moves) {
+                board.place(cell, side);
+                Numbers child = numbersOf(board, other, cell);
+                board.remove(cell);
+
+                numbers.delta = add(numbers.delta, child.phi);
+                if (child.delta < numbers.phi) {
+                    secondDelta = numbers.phi;
+                    numbers.phi = child.delta;
+                    best = cell;
+                    bestPhi = child.phi;
+                }
+                else if (child.delta < secondDelta) {
+                    secondDelta = child.delta;
+                }
+            }
+
+            store(board, numbers);
+            if (numbers.phi >= phiLimit || numbers.delta >= deltaLimit) {
+                return;
+            }
+
+            // the child may grow until it is no longer the best one or the parent reaches its delta limit
+            uint32_t childPhiLimit = deltaLimit - (numbers.delta - bestPhi);
+            uint32_t childDeltaLimit = std::min(phiLimit, add(secondDelta, 1));
+
+            board.place(best, side);
+            expand(board, other, best, childPhiLimit, childDeltaLimit);
+            board.remove(best);
+        }
+    }
+
+    // prove or disprove that the given player wins from the position and return the numbers of the root
+    Numbers prove(const BoardType& board, Player player) {
+        BoardType copy = board;
+        attacker = player;
+
+        expand(copy, copy.sideToMove(), -1, INFINITE_PROOF, INFINITE_PROOF);
+        return numbersOf(copy, copy.sideToMove(), -1);
+    }
+
+    // return a move of the position to a child whose player to move fails, one exists when the root succeeds
+    int successfulMove(const BoardType& board) const {
+        BoardType copy = board;
+        Player side = copy.sideToMove();
+        Player other = (side == X) ? O : X;
+
+        for (Mask open = candidateMoves(copy, side); open; open &= open - 1) {
+            int cell = lowestBit(open);
+            copy.place(cell, side);
+            Numbers child = numbersOf(copy, other, cell);
+            copy.remove(cell);
+
+            if (child.delta == 0) {
+                return cell;
+            }
+        }
+
+        return -1;
+    }
+
+public:
+    // constructor to initialize a solver whose table uses at most the given number of megabytes
+    explicit ProofSearch(size_t megabytes = 16)
+        : slotCount(1), attacker(X), nodes(0), hasDeadline(false), nodeLimit(0), stopped(false),
+          stopFlag(nullptr) {
+        size_t budget = std::max<size_t>(megabytes, 1) * 1024 * 1024 / sizeof(Slot);
+        while (slotCount * 2 <= budget) {
+            slotCount *= 2;
+        }
+        slots = std::make_unique<Slot[]>(slotCount);
+    }
+
+    ProofSearch(const ProofSearch&) = delete;
+    ProofSearch& operator=(const ProofSearch&) = delete;
+
+    // stop the solver as soon as the given flag is set by another thread, nullptr removes the flag
+    void setStopFlag(const std::atomic<bool>* flag) {
+        stopFlag = flag;
+    }
+
+    // remove every number of the table
+    void clear() {
+        std::fill(slots.get(), slots.get() + slotCount, Slot{ 0, Numbers{ 0, 0 } });
+    }
+
+    // return the number of slots of the table
+    size_t size() const {
+        return slotCount;
+    }
+
+    // return the number of positions expanded by the last solve
+    uint64_t getNodes() const {
+        return nodes;
+    }
+
+    // solve the position within the limits and return its value for the player to move, the numbers of the
+    // table are kept so solving the positions of one game one after another gets faster
+    Result solve(const BoardType& board, const SearchLimits& limits = SearchLimits()) {
+        nodes = 0;
+        stopped = false;
+        nodeLimit = limits.nodes;
+        hasDeadline = (limits.milliseconds > 0);
+        deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(limits.milliseconds);
+
+        Player side = board.sideToMove();
+        Player other = (side == X) ? O : X;
+        Result result = { Unproven, -1, 0, 0, 0 };
+
+        if (board.hasWin(other) || board.isFull()) {
+            result.result = board.hasWin(other) ? ProvenLoss : ProvenDraw;
+            return result;
+        }
+
+        // the player to move is the attacker, its phi and delta are the proof and disproof numbers
+        Numbers win = prove(board, side);
+        result.proof = win.phi;
+        result.disproof = win.delta;
+        if (win.phi == 0) {
+            result.result = ProvenWin;
+            result.cell = successfulMove(board);
+        }
+        else if (win.delta == 0) {
+            // the opponent is the attacker, the proof number is the delta of the player to move
+            Numbers loss = prove(board, other);
+            result.proof = loss.delta;
+            result.disproof = loss.phi;
+            if (loss.phi == 0) {
+                result.result = ProvenDraw;
+                result.cell = successfulMove(board);
+            }
+            else if (loss.delta == 0) {
+                result.result = ProvenLoss;
+                result.cell = lowestBit(candidateMoves(board, side));
+            }
+        }
+
+        result.nodes = nodes;
+        return result;
+    }
+};
@@ -0,0 +1,64 @@
+#include "BoardSizes.h"
+#include "ProofSearch.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+// play the moves and solve the position, return false if a move is illegal
+template <typename BoardType>
+static bool solve(size_t megabytes, const SearchLimits& limits, const vector<int>& moves) {
+    BoardType board;
+    for (int cell : moves) {
+        if (cell < 0 || cell >= BoardType::CELLS || !(board.empty() & BoardType::bit(cell))) {
+            cerr << "illegal move " << cell << endl;
+            return false;
+        }
+        board.place(cell, board.sideToMove());
+    }
+
+    ProofSearch<BoardType> solver(megabytes);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    typename ProofSearch<BoardType>::Result result = solver.solve(board, limits);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    const char* names[] = { "unproven", "win", "draw", "loss" };
+    cout << "result: " << names[result.result] << " for the player to move" << endl;
+    cout << "cell: " << result.cell << endl;
+    cout << "proof number: " << result.proof << ", disproof number: " << result.disproof << endl;
+    cout << "nodes: " << result.nodes << " (" << static_cast<uint64_t>(result.nodes / max(seconds, 1e-9))
+         << " per second)" << endl;
+    return true;
+}
+
+// ProofSolver <rows> <cols> <k> <megabytes> <milliseconds> [cells of the moves played so far]
+int main(int argc, char* argv[]) {
+    if (argc < 6) {
+        cerr << "usage: ProofSolver <rows> <cols> <k> <megabytes> <milliseconds> [cells of the moves played so far]"
+             << endl;
+        return 1;
+    }
+
+    int rows = atoi(argv[1]);
+    int cols = atoi(argv[2]);
+    int k = atoi(argv[3]);
+    size_t megabytes = static_cast<size_t>(atoll(argv[4]));
+    SearchLimits limits;
+    limits.milliseconds = atoll(argv[5]);
+    vector<int> moves;
+    for (int i = 6; i < argc; i++) {
+        moves.push_back(atoi(argv[i]));
+    }
+    bool solved = false;
+
+    bool supported = withBoardSize(rows, cols, k, [&](auto board) {
+        solved = solve<decltype(board)>(megabytes, limits, moves);
+    });
+    if (!supported) {
+        cerr << "unsupported board " << rows << "x" << cols << " with " << k << " in a row" << endl;
+        return 1;
+    }
+
+    return solved ? 0 : 1;
+}
@@ -0,0 +1,11 @@
+#include "Random.h"
+#include <atomic>
+using namespace std;
+
+// the stream of the next thread that asks for its generator
+static atomic<uint64_t> nextStream(0);
+
+Random& Random::local() {
+    thread_local Random random = Random::stream(0, nextStream++);
+    return random;
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+// one step of the splitmix64 generator, used to fill the zobrist keys at compile time and to seed Random
+constexpr uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Random is the xoshiro256** generator used for every random choice of the AI, every AI and every thread owns
+// its own one so games don't share hidden state, the same seed always gives the same numbers and jump() moves
+// to a stream that doesn't overlap the current one so parallel games can start from one seed
+class Random {
+private:
+    std::array<uint64_t, 4> state; // the state of the generator, never all zero
+
+    // rotate the bits of the value left
+    static constexpr uint64_t rotate(uint64_t value, int bits) {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+public:
+    // constructor to initialize the generator from the given seed
+    explicit constexpr Random(uint64_t seed = 0) : state{} {
+        this->seed(seed);
+    }
+
+    // restart the generator from the given seed, the state is filled by splitmix64 so any seed works
+    constexpr void seed(uint64_t value) {
+        for (uint64_t& word : state) {
+            word = splitMix64(value);
+        }
+    }
+
+    // return the next 64 random bits
+    constexpr uint64_t next() {
+        uint64_t result = rotate(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotate(state[3], 45);
+
+        return result;
+    }
+
+    // return a random number below the given bound without bias, the 64-bit product is rejected in the rare
+    // cases that would favor the low numbers (Lemire's method)
+    constexpr uint32_t below(uint32_t bound) {
+        uint64_t product = (next() >> 32) * bound;
+        uint32_t low = static_cast<uint32_t>(product);
+
+        if (low < bound) {
+            uint32_t threshold = static_cast<uint32_t>(-bound) % bound;
+            while (low < threshold) {
+                product = (next() >> 32) * bound;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    // move the generator 2 ^ 128 numbers ahead, the streams of successive jumps never overlap
+    constexpr void jump() {
+        constexpr uint64_t JUMP[4] = { 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL,
+                                       0x39ABDC4529B1661CULL };
+        std::array<uint64_t, 4> jumped{};
+
+        for (uint64_t word : JUMP) {
+            for (int bit = 0; bit < 64; bit++) {
+                if (word & (uint64_t(1) << bit)) {
+                    for (int i = 0; i < 4; i++) {
+                        jumped[i] ^= state[i];
+                    }
+                }
+                next();
+            }
+        }
+
+        state = jumped;
+    }
+
+    // return the generator of the given stream of the seed, the seeded generator jumped index times
+    static constexpr Random stream(uint64_t seed, uint64_t index) {
+        Random random(seed);
+        for (uint64_t i = 0; i < index; i++) {
+            random.jump();
+        }
+
+        return random;
+    }
+
+    // return the generator of the calling thread, every thread gets the next stream of the seed 0 on its first
+    // call, for code that has no generator of its own
+    static Random& local();
+};
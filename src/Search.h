@@ -0,0 +1,462 @@
+#pragma once
+#include "Board.h"
+#include "Evaluator.h"
+#include "MoveGen.h"
+#include "TranspositionTable.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <utility>
+
+// the score of winning right now, a win found p plies later is worth WIN_SCORE - p so quick wins and slow
+// losses are preferred
+constexpr int WIN_SCORE = 10000;
+
+// the scores above it are wins and the scores below its negation are losses
+constexpr int WIN_THRESHOLD = WIN_SCORE - 1000;
+
+// bigger than any score, used as the initial window
+constexpr int INFINITE_SCORE = WIN_SCORE + 1;
+
+// the budget of one search, a search that runs out of it stops and keeps the last completed depth
+struct SearchLimits {
+    int64_t milliseconds = 0; // the wall-clock time of the search or 0 for no time limit
+    uint64_t nodes = 0; // the number of positions the search can visit or 0 for no node limit
+};
+
+// the counters of a search, the cutoffs and the deepest ply cost a little in the hottest loop of the search so
+// they are only counted when TICTACTOE_SEARCH_STATS is defined (the TICTACTOE_SEARCH_STATS cmake option), every
+// thread counts into its own search and the counters are added up once the threads are done
+struct SearchCounters {
+    uint64_t nodes = 0; // the number of visited positions
+    uint64_t cutoffs = 0; // the number of moves that failed high and cut their siblings
+    int maxPly = 0; // the deepest ply a position was visited at
+    uint64_t tableHits = 0; // the number of transposition table probes that found their position
+    uint64_t tableStores = 0; // the number of entries stored in the transposition table
+
+    // add the counters of another search, of another thread or another move
+    void add(const SearchCounters& other) {
+        nodes += other.nodes;
+        cutoffs += other.cutoffs;
+        maxPly = std::max(maxPly, other.maxPly);
+        tableHits += other.tableHits;
+        tableStores += other.tableStores;
+    }
+};
+
+// Search is the negamax search core of the AI for any board size, it uses alpha-beta with principal variation
+// search, the transposition table and move ordering (the table move first, then the killer moves of the ply,
+// then the history heuristic and at last the cells crossed by more winning lines, the center and the corners)
+//
+// the positions at the depth limit are scored by the Evaluator, it follows every move of a depth-limited search
+// so it can keep its scores up to date instead of scoring the whole board at every leaf (see LineEvaluator), a
+// search deep enough to reach the end of the game never evaluates so it doesn't follow the moves
+template <typename BoardType, typename Evaluator = DefaultEvaluator<BoardType>>
+class Search {
+public:
+    using Mask = typename BoardType::Mask;
+    using EvaluatorType = Evaluator;
+
+    static_assert(Evaluator::MAX_SCORE < WIN_THRESHOLD, "an evaluated position must score less than a win");
+
+    // the deepest ply a search can reach
+    static constexpr int MAX_PLY = BoardType::CELLS + 1;
+
+    // the result of a root search
+    struct Result {
+        int cell; // the best cell or -1 if there is no move
+        int score; // the score of the best cell for the player to move
+    };
+
+private:
+    TranspositionTable& table; // the searched positions, shared between searches
+    std::array<std::array<int, 2>, MAX_PLY> killers; // the last two moves that caused a cutoff at every ply
+    std::array<std::array<int, BoardType::CELLS>, 2> history; // how much every move of every player caused cutoffs
+    uint64_t nodes; // the number of visited positions
+    uint64_t cutoffs; // the number of beta cutoffs, only counted with TICTACTOE_SEARCH_STATS
+    int maxPly; // the deepest visited ply, only counted with TICTACTOE_SEARCH_STATS
+    uint64_t tableHits; // the number of table probes that found their position
+    uint64_t tableStores; // the number of entries stored in the table
+    std::chrono::steady_clock::time_point deadline; // the time the search has to stop at
+    bool hasDeadline; // if the search has a time limit
+    uint64_t nodeLimit; // the number of positions the search can visit or 0 for no node limit
+    bool limitsActive; // if the limits are checked, the first depth always runs to the end to have a move
+    bool stopped; // if the search ran out of its budget, the results found after that are discarded
+    const std::atomic<bool>* stopFlag; // set by another thread to stop the search or nullptr
+    int completedDepth; // the deepest depth the last iterative deepening completed
+    Evaluator evaluator; // scores the positions at the depth limit, it follows the moves of the search
+    bool evaluating; // if the current search can stop before the end of the game and needs the evaluator
+
+    // start following the moves from the board if a search of the given depth can stop before the end
+    void startEvaluating(const BoardType& board, int depth) {
+        evaluating = depth < BoardType::CELLS - board.moveCount();
+        if (evaluating) {
+            evaluator.reset(board);
+        }
+    }
+
+    // check if the search ran out of its budget, the clock is only read every 1024 positions
+    bool shouldStop() {
+        if (stopped) {
+            return true;
+        }
+        if (!limitsActive) {
+            return false;
+        }
+        if (stopFlag != nullptr && stopFlag->load(std::memory_order_relaxed)) {
+            stopped = true;
+        }
+        else if (nodeLimit != 0 && nodes >= nodeLimit) {
+            stopped = true;
+        }
+        else if (hasDeadline && (nodes & 1023) == 0 && std::chrono::steady_clock::now() >= deadline) {
+            stopped = true;
+        }
+
+        return stopped;
+    }
+
+    // turn a score relative to the root into one relative to the position at the given ply for the table
+    static int toTable(int score, int ply) {
+        return (score > WIN_THRESHOLD) ? score + ply : (score < -WIN_THRESHOLD) ? score - ply : score;
+    }
+
+    // turn a score from the table into one relative to the root
+    static int fromTable(int score, int ply) {
+        return (score > WIN_THRESHOLD) ? score - ply : (score < -WIN_THRESHOLD) ? score + ply : score;
+    }
+
+    // give every move of the list its ordering score
+    void scoreMoves(const MoveList<BoardType::CELLS>& moves, std::array<int, BoardType::CELLS>& scores,
+                    Player side, int ttMove, int ply) const {
+        for (int i = 0; i < moves.size(); i++) {
+            int cell = moves[i];
+
+            if (cell == ttMove) {
+                scores[i] = 1 << 30;
+            }
+            else if (cell == killers[ply][0]) {
+                scores[i] = 1 << 29;
+            }
+            else if (cell == killers[ply][1]) {
+                scores[i] = 1 << 28;
+            }
+            else {
+                scores[i] = history[side][cell] * 16 + BoardType::CELL_LINES[cell].count;
+            }
+        }
+    }
+
+    // move the best scored move from index i on to index i
+    static void pickMove(MoveList<BoardType::CELLS>& moves, std::array<int, BoardType::CELLS>& scores, int i) {
+        int best = i;
+
+        for (int j = i + 1; j < moves.size(); j++) {
+            if (scores[j] > scores[best]) {
+                best = j;
+            }
+        }
+
+        std::swap(moves[i], moves[best]);
+        std::swap(scores[i], scores[best]);
+    }
+
+    // remember a move that caused a cutoff
+    void updateHeuristics(int cell, Player side, int depth, int ply) {
+        if (killers[ply][0] != cell) {
+            killers[ply][1] = killers[ply][0];
+            killers[ply][0] = cell;
+        }
+
+        history[side][cell] += depth * depth;
+    }
+
+public:
+    // constructor to initialize a search that uses the given transposition table
+    explicit Search(TranspositionTable& transpositionTable)
+        : table(transpositionTable), nodes(0), cutoffs(0), maxPly(0), tableHits(0), tableStores(0),
+          hasDeadline(false), nodeLimit(0), limitsActive(false), stopped(false), stopFlag(nullptr), completedDepth(0),
+          evaluating(false) {
+        for (auto& ply : killers) {
+            ply = { -1, -1 };
+        }
+        for (auto& side : history) {
+            side.fill(0);
+        }
+    }
+
+    // return the number of visited positions
+    uint64_t getNodes() const {
+        return nodes;
+    }
+
+    // return the counters of every search run by this object
+    SearchCounters getCounters() const {
+        return SearchCounters{ nodes, cutoffs, maxPly, tableHits, tableStores };
+    }
+
+    // stop the search as soon as the given flag is set by another thread, nullptr removes the flag
+    void setStopFlag(const std::atomic<bool>* flag) {
+        stopFlag = flag;
+    }
+
+    // start the history of the moves from small random values of the given seed, so searches of the same position
+    // with different seeds try the moves that are worth the same in a different order (the helpers of Lazy SMP)
+    void perturbOrder(uint64_t seed) {
+        Random random(seed);
+
+        for (auto& side : history) {
+            for (int& value : side) {
+                value = static_cast<int>(random.below(4));
+            }
+        }
+    }
+
+    // start the budget of a search that began at the given time, the limits are only checked once active
+    void setLimits(const SearchLimits& limits, std::chrono::steady_clock::time_point start) {
+        hasDeadline = limits.milliseconds > 0;
+        deadline = start + std::chrono::milliseconds(limits.milliseconds);
+        nodeLimit = limits.nodes;
+        stopped = false;
+    }
+
+    // choose if the limits and the stop flag are checked
+    void setLimitsActive(bool active) {
+        limitsActive = active;
+    }
+
+    // check if the last search ran out of its budget
+    bool wasStopped() const {
+        return stopped;
+    }
+
+    // return the deepest depth the last iterative deepening completed
+    int getCompletedDepth() const {
+        return completedDepth;
+    }
+
+    // search the position to the given depth and return its score for the player to move, lastCell is the cell
+    // of the move that led to the position or -1, the board is the same when it returns, the evaluator must
+    // follow the board if the search can stop before the end (searchRoot and searchMove see to it)
+    int negamax(BoardType& board, int depth, int ply, int alpha, int beta, int lastCell) {
+        if (shouldStop()) {
+            return 0;
+        }
+        nodes++;
+#if defined(TICTACTOE_SEARCH_STATS)
+        maxPly = std::max(maxPly, ply);
+#endif
+
+        // the player who just played is the only one who can have won
+        Player side = board.sideToMove();
+        if (lastCell >= 0 && board.isWinAt(lastCell, (side == X) ? O : X)) {
+            return -(WIN_SCORE - ply);
+        }
+        if (board.isFull()) {
+            return 0;
+        }
+        if (depth <= 0) {
+            return evaluator.evaluate(side);
+        }
+
+        // use what is known about the position
+        int ttMove = -1;
+        TTEntry entry;
+        if (table.probe(board.hash(), entry)) {
+            tableHits++;
+            ttMove = entry.bestMove;
+
+            if (entry.depth >= depth) {
+                int score = fromTable(entry.score, ply);
+
+                if (entry.bound == Exact) {
+                    return score;
+                }
+                else if (entry.bound == LowerBound && score > alpha) {
+                    alpha = score;
+                }
+                else if (entry.bound == UpperBound && score < beta) {
+                    beta = score;
+                }
+
+                if (alpha >= beta) {
+                    return score;
+                }
+            }
+        }
+
+        int alphaBefore = alpha;
+        int bestScore = -INFINITE_SCORE;
+        int bestCell = -1;
+        MoveList<BoardType::CELLS> moves(board.empty());
+        std::array<int, BoardType::CELLS> scores;
+        scoreMoves(moves, scores, side, ttMove, ply);
+
+        for (int i = 0; i < moves.size(); i++) {
+            pickMove(moves, scores, i);
+            int cell = moves[i];
+            int score;
+
+            board.place(cell, side);
+            if (evaluating) {
+                evaluator.place(cell, side);
+            }
+
+            // the first move gets the whole window and the others only have to prove they are worse
+            if (i == 0) {
+                score = -negamax(board, depth - 1, ply + 1, -beta, -alpha, cell);
+            }
+            else {
+                score = -negamax(board, depth - 1, ply + 1, -alpha - 1, -alpha, cell);
+                if (score > alpha && score < beta) {
+                    score = -negamax(board, depth - 1, ply + 1, -beta, -alpha, cell);
+                }
+            }
+
+            board.remove(cell);
+            if (evaluating) {
+                evaluator.remove(cell, side);
+            }
+
+            // the score of an unfinished search means nothing
+            if (stopped) {
+                return 0;
+            }
+
+            if (score > bestScore) {
+                bestScore = score;
+                bestCell = cell;
+            }
+            if (score > alpha) {
+                alpha = score;
+            }
+            if (alpha >= beta) {
+#if defined(TICTACTOE_SEARCH_STATS)
+                cutoffs++;
+#endif
+                updateHeuristics(cell, side, depth, ply);
+                break;
+            }
+        }
+
+        Bound bound = (bestScore <= alphaBefore) ? UpperBound : (bestScore >= beta) ? LowerBound : Exact;
+        if (table.store(board.hash(), toTable(bestScore, ply), depth, bound, bestCell)) {
+            tableStores++;
+        }
+
+        return bestScore;
+    }
+
+    // play the cell for the player to move, search the reply to the given depth and return the score of the
+    // cell for the player to move
+    int searchMove(BoardType& board, int cell, int depth, int alpha, int beta) {
+        startEvaluating(board, depth);
+        if (evaluating) {
+            evaluator.place(cell, board.sideToMove());
+        }
+        board.place(cell, board.sideToMove());
+        int score = -negamax(board, depth - 1, 1, -beta, -alpha, cell);
+        board.remove(cell);
+
+        return score;
+    }
+
+    // search the given root moves to the given depth and return the best one, the window is shared between
+    // the root moves so every move after the first one only has to prove it is worse
+    Result searchRoot(BoardType& board, int depth, Mask rootMoves) {
+        Result result = { -1, -INFINITE_SCORE };
+        Player side = board.sideToMove();
+        int alpha = -INFINITE_SCORE;
+        int beta = INFINITE_SCORE;
+
+        int ttMove = -1;
+        TTEntry entry;
+        if (table.probe(board.hash(), entry)) {
+            tableHits++;
+            ttMove = entry.bestMove;
+        }
+
+        MoveList<BoardType::CELLS> moves(rootMoves);
+        std::array<int, BoardType::CELLS> scores;
+        scoreMoves(moves, scores, side, ttMove, 0);
+        startEvaluating(board, depth);
+
+        for (int i = 0; i < moves.size(); i++) {
+            pickMove(moves, scores, i);
+            int cell = moves[i];
+            int score;
+
+            board.place(cell, side);
+            if (evaluating) {
+                evaluator.place(cell, side);
+            }
+
+            if (i == 0) {
+                score = -negamax(board, depth - 1, 1, -beta, -alpha, cell);
+            }
+            else {
+                score = -negamax(board, depth - 1, 1, -alpha - 1, -alpha, cell);
+                if (score > alpha) {
+                    score = -negamax(board, depth - 1, 1, -beta, -alpha, cell);
+                }
+            }
+
+            board.remove(cell);
+            if (evaluating) {
+                evaluator.remove(cell, side);
+            }
+
+            if (stopped) {
+                return result;
+            }
+
+            if (score > result.score) {
+                result = Result{ cell, score };
+            }
+            if (score > alpha) {
+                alpha = score;
+            }
+        }
+
+        if (result.cell >= 0 && table.store(board.hash(), result.score, depth, Exact, result.cell)) {
+            tableStores++;
+        }
+
+        return result;
+    }
+
+    // search the given root moves one depth more at a time from startDepth up to maxDepth until the budget runs
+    // out, and return the best move of the last completed depth, the first depth is never stopped so there is
+    // always a move
+    Result iterativeDeepening(BoardType& board, int maxDepth, Mask rootMoves, const SearchLimits& limits,
+                              int startDepth = 1) {
+        Result best = { -1, -INFINITE_SCORE };
+
+        setLimits(limits, std::chrono::steady_clock::now());
+        completedDepth = 0;
+
+        for (int depth = startDepth; depth <= maxDepth; depth++) {
+            limitsActive = depth > 1;
+            Result result = searchRoot(board, depth, rootMoves);
+
+            if (stopped) {
+                break;
+            }
+
+            best = result;
+            completedDepth = depth;
+
+            // a win or loss proven within the searched depth doesn't change with more depth, one found further
+            // through the table may still have a quicker alternative
+            if ((best.score > WIN_THRESHOLD || best.score < -WIN_THRESHOLD) && WIN_SCORE - abs(best.score) <= depth) {
+                break;
+            }
+        }
+
+        limitsActive = false;
+        return best;
+    }
+};
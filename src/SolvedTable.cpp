@@ -0,0 +1,7 @@
+#include "SolvedTable.h"
+
+// the whole game tree is solved while compiling this file, nothing is searched at runtime
+constexpr SolvedTable SOLVED_TABLE = solveTicTacToe();
+
+// tic-tac-toe is a draw with perfect play
+static_assert(SOLVED_TABLE[0].score == 0, "the empty grid must be a draw");
@@ -0,0 +1,91 @@
+#pragma once
+#include "Board.h"
+#include <array>
+#include <cstdint>
+
+// the solved value of one 3x3 position
+struct SolvedEntry {
+    // the score for the player to move: 10 - plies to the end for a win, plies to the end - 10 for a loss
+    // and 0 for a draw, so quick wins and slow losses are preferred
+    int8_t score;
+    // the cell to play, TERMINAL if the game is over and UNREACHABLE if the position can't happen in a game
+    int8_t bestCell;
+};
+
+// the solved value of every 3x3 position indexed by its base-3 index
+struct SolvedTable {
+    static constexpr int8_t TERMINAL = -1;
+    static constexpr int8_t UNREACHABLE = -2;
+
+    std::array<SolvedEntry, 19683> entries;
+
+    // return the entry of the position with the given base-3 index
+    constexpr const SolvedEntry& operator[](uint32_t index) const {
+        return entries[index];
+    }
+};
+
+// solve the position by negamax and store the result of every position reached below it, index is the base-3
+// index of the board and the player who just played is the only one who can have won
+constexpr int8_t solvePosition(SolvedTable& table, Board<3, 3, 3>& board, uint32_t index, Player toMove) {
+    constexpr uint32_t POWERS[9] = { 1, 3, 9, 27, 81, 243, 729, 2187, 6561 };
+
+    // the position is already solved through another move order
+    if (table.entries[index].bestCell != SolvedTable::UNREACHABLE) {
+        return table.entries[index].score;
+    }
+
+    // the game is over, either the last player won or the grid is full
+    if (board.hasWin((toMove == X) ? O : X) || board.isFull()) {
+        int8_t score = board.isFull() && !board.hasWin((toMove == X) ? O : X) ? 0 : -10;
+        table.entries[index] = SolvedEntry{ score, SolvedTable::TERMINAL };
+        return score;
+    }
+
+    int8_t bestScore = -127;
+    int8_t bestCell = SolvedTable::TERMINAL;
+
+    for (int cell = 0; cell < 9; cell++) {
+        if (board.occupied() & board.bit(cell)) {
+            continue;
+        }
+
+        board.place(cell, toMove);
+        int8_t score = -solvePosition(table, board, index + ((toMove == X) ? 1 : 2) * POWERS[cell], (toMove == X) ? O : X);
+        board.remove(cell);
+
+        // a result one ply further away is worth one point less
+        if (score > 0) {
+            score--;
+        }
+        else if (score < 0) {
+            score++;
+        }
+
+        // the first best cell is kept so the choice is the same as a row by row search
+        if (score > bestScore) {
+            bestScore = score;
+            bestCell = static_cast<int8_t>(cell);
+        }
+    }
+
+    table.entries[index] = SolvedEntry{ bestScore, bestCell };
+    return bestScore;
+}
+
+// solve every position reachable from the empty grid, it is meant to run at compile time
+constexpr SolvedTable solveTicTacToe() {
+    SolvedTable table{};
+
+    for (SolvedEntry& entry : table.entries) {
+        entry = SolvedEntry{ 0, SolvedTable::UNREACHABLE };
+    }
+
+    Board<3, 3, 3> board;
+    solvePosition(table, board, 0, X);
+
+    return table;
+}
+
+// the solved 3x3 game, computed by the compiler and stored in the binary
+extern const SolvedTable SOLVED_TABLE;
@@ -0,0 +1,198 @@
+#pragma once
+#include "Board.h"
+#include <array>
+
+// the cell that [row, column] goes to under the given symmetry of a rows x cols grid, the first 4 symmetries
+// (identity, rotation by 180, mirror of the columns, mirror of the rows) work for any grid while the last 4
+// (transpose, rotation by 90, rotation by 270, anti-transpose) only work for square grids
+constexpr int mapSymmetryCell(int transform, int row, int column, int rows, int cols) {
+    switch (transform) {
+        case 0: return row * cols + column;
+        case 1: return (rows - 1 - row) * cols + (cols - 1 - column);
+        case 2: return row * cols + (cols - 1 - column);
+        case 3: return (rows - 1 - row) * cols + column;
+        case 4: return column * cols + row;
+        case 5: return column * cols + (rows - 1 - row);
+        case 6: return (cols - 1 - column) * cols + row;
+        default: return (cols - 1 - column) * cols + (rows - 1 - row);
+    }
+}
+
+// CELL_MAP[transform][cell] of Symmetry, the cell that cell goes to under the transform
+template <typename BoardType, int Count>
+constexpr std::array<std::array<int, BoardType::CELLS>, Count> makeSymmetryCellMap() {
+    std::array<std::array<int, BoardType::CELLS>, Count> map{};
+
+    for (int t = 0; t < Count; t++) {
+        for (int row = 0; row < BoardType::ROWS; row++) {
+            for (int col = 0; col < BoardType::COLS; col++) {
+                map[t][BoardType::index(row, col)] = mapSymmetryCell(t, row, col, BoardType::ROWS, BoardType::COLS);
+            }
+        }
+    }
+
+    return map;
+}
+
+// MASK_MAP[transform][chunk][byte] of Symmetry, the mask that the 8 cells of the chunk go to under the transform
+template <typename BoardType, int Count, int Chunks>
+constexpr std::array<std::array<std::array<typename BoardType::Mask, 256>, Chunks>, Count> makeSymmetryMaskMap() {
+    std::array<std::array<std::array<typename BoardType::Mask, 256>, Chunks>, Count> map{};
+    constexpr std::array<std::array<int, BoardType::CELLS>, Count> cellMap = makeSymmetryCellMap<BoardType, Count>();
+
+    for (int t = 0; t < Count; t++) {
+        for (int chunk = 0; chunk < Chunks; chunk++) {
+            for (int value = 0; value < 256; value++) {
+                typename BoardType::Mask mask = 0;
+                for (int i = 0; i < 8 && chunk * 8 + i < BoardType::CELLS; i++) {
+                    if (value & (1 << i)) {
+                        mask |= BoardType::bit(cellMap[t][chunk * 8 + i]);
+                    }
+                }
+                map[t][chunk][value] = mask;
+            }
+        }
+    }
+
+    return map;
+}
+
+// INVERSE[transform] of Symmetry, the transform that undoes it
+template <typename BoardType, int Count>
+constexpr std::array<int, Count> makeSymmetryInverse() {
+    std::array<int, Count> inverse{};
+    constexpr std::array<std::array<int, BoardType::CELLS>, Count> cellMap = makeSymmetryCellMap<BoardType, Count>();
+
+    for (int t = 0; t < Count; t++) {
+        for (int u = 0; u < Count; u++) {
+            bool undoes = true;
+            for (int cell = 0; cell < BoardType::CELLS; cell++) {
+                if (cellMap[u][cellMap[t][cell]] != cell) {
+                    undoes = false;
+                    break;
+                }
+            }
+            if (undoes) {
+                inverse[t] = u;
+                break;
+            }
+        }
+    }
+
+    return inverse;
+}
+
+// Symmetry maps positions and moves of a board to their equivalent ones under the symmetries of the grid,
+// every transform is a lookup table generated at compile time: one table maps cells and one maps a mask
+// 8 cells at a time
+template <typename BoardType>
+class Symmetry {
+public:
+    using Mask = typename BoardType::Mask;
+
+    // the number of symmetries of the grid, 8 for square grids and 4 for the others
+    static constexpr int COUNT = (BoardType::ROWS == BoardType::COLS) ? 8 : 4;
+
+    // the number of 8-bit chunks of a mask
+    static constexpr int CHUNKS = (BoardType::CELLS + 7) / 8;
+
+    // the result of a canonicalization, the canonical board and the transform that maps the board to it
+    struct Canonical {
+        BoardType board;
+        int transform;
+    };
+
+    // the lookup tables of the transforms
+    static constexpr std::array<std::array<int, BoardType::CELLS>, COUNT> CELL_MAP = makeSymmetryCellMap<BoardType, COUNT>();
+    static constexpr std::array<std::array<std::array<Mask, 256>, CHUNKS>, COUNT> MASK_MAP =
+        makeSymmetryMaskMap<BoardType, COUNT, CHUNKS>();
+    static constexpr std::array<int, COUNT> INVERSE = makeSymmetryInverse<BoardType, COUNT>();
+
+    // return the transform that undoes the given one
+    static constexpr int inverse(int transform) {
+        return INVERSE[transform];
+    }
+
+    // return the cell that the given cell goes to under the transform
+    static constexpr int transformCell(int cell, int transform) {
+        return CELL_MAP[transform][cell];
+    }
+
+    // return the move that the given move goes to under the transform
+    static constexpr Move transformMove(Move move, int transform) {
+        int cell = CELL_MAP[transform][BoardType::index(move.row, move.column)];
+        return Move{ cell / BoardType::COLS, cell % BoardType::COLS };
+    }
+
+    // return the mask that the given mask goes to under the transform
+    static constexpr Mask transformMask(Mask mask, int transform) {
+        Mask result = 0;
+
+        for (int chunk = 0; chunk < CHUNKS; chunk++) {
+            result |= MASK_MAP[transform][chunk][(mask >> (chunk * 8)) & 0xFF];
+        }
+
+        return result;
+    }
+
+    // return the board that the given board goes to under the transform
+    static constexpr BoardType transform(const BoardType& board, int transform) {
+        return BoardType::fromMasks(transformMask(board.getXMask(), transform), transformMask(board.getOMask(), transform));
+    }
+
+    // return the canonical board of the equivalence class of the given board (the one with the smallest
+    // masks) and the transform that maps the board to it
+    static constexpr Canonical canonical(const BoardType& board) {
+        Mask bestX = board.getXMask();
+        Mask bestO = board.getOMask();
+        int bestTransform = 0;
+
+        for (int t = 1; t < COUNT; t++) {
+            Mask x = transformMask(board.getXMask(), t);
+            Mask o = transformMask(board.getOMask(), t);
+
+            if (x < bestX || (x == bestX && o < bestO)) {
+                bestX = x;
+                bestO = o;
+                bestTransform = t;
+            }
+        }
+
+        if (bestTransform == 0) {
+            return Canonical{ board, 0 };
+        }
+
+        return Canonical{ BoardType::fromMasks(bestX, bestO), bestTransform };
+    }
+
+    // return the open cells that aren't equivalent to a smaller open cell under a symmetry of the board,
+    // searching only these cells gives the same result as searching all of them
+    static constexpr Mask uniqueMoves(const BoardType& board) {
+        Mask open = board.empty();
+        int symmetries[COUNT] = {};
+        int count = 0;
+
+        // the transforms that leave the board as it is
+        for (int t = 1; t < COUNT; t++) {
+            if (transformMask(board.getXMask(), t) == board.getXMask() &&
+                transformMask(board.getOMask(), t) == board.getOMask()) {
+                symmetries[count++] = t;
+            }
+        }
+
+        Mask unique = open;
+        for (int cell = 0; cell < BoardType::CELLS; cell++) {
+            if (!(open & BoardType::bit(cell))) {
+                continue;
+            }
+            for (int i = 0; i < count; i++) {
+                if (CELL_MAP[symmetries[i]][cell] < cell) {
+                    unique &= ~BoardType::bit(cell);
+                    break;
+                }
+            }
+        }
+
+        return unique;
+    }
+};
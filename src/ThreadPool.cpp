@@ -0,0 +1,45 @@
+#include "ThreadPool.h"
+using namespace std;
+
+ThreadPool::ThreadPool(int threads) : stopping(false) {
+    for (int i = 0; i < max(threads, 1); i++) {
+        workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(tasksMutex);
+        stopping = true;
+    }
+    available.notify_all();
+
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+int ThreadPool::size() const {
+    return static_cast<int>(workers.size());
+}
+
+void ThreadPool::work() {
+    while (true) {
+        function<void()> task;
+
+        {
+            unique_lock<mutex> lock(tasksMutex);
+            available.wait(lock, [this]() { return stopping || !tasks.empty(); });
+
+            // the waiting tasks are finished before stopping
+            if (tasks.empty()) {
+                return;
+            }
+
+            task = move(tasks.front());
+            tasks.pop();
+        }
+
+        task();
+    }
+}
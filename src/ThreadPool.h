@@ -0,0 +1,53 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// ThreadPool keeps a fixed number of worker threads alive and runs the submitted tasks on them in order,
+// so a parallel search doesn't pay for starting threads on every move
+class ThreadPool {
+private:
+    std::vector<std::thread> workers; // the worker threads
+    std::queue<std::function<void()>> tasks; // the tasks waiting for a worker
+    std::mutex tasksMutex; // protects the tasks and the stopping flag
+    std::condition_variable available; // signaled when a task is added or the pool stops
+    bool stopping; // if the pool is being destroyed
+
+    // the loop of every worker, run tasks until the pool stops
+    void work();
+
+public:
+    // constructor to start the given number of worker threads, at least one
+    explicit ThreadPool(int threads);
+
+    // destructor to finish the waiting tasks and join the workers
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // return the number of worker threads
+    int size() const;
+
+    // run the task on a worker and return a future of its result
+    template <typename Task>
+    auto submit(Task task) -> std::future<decltype(task())> {
+        using Result = decltype(task());
+
+        // packaged_task isn't copyable so it is shared to fit in a std::function
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::move(task));
+        std::future<Result> result = packaged->get_future();
+
+        {
+            std::lock_guard<std::mutex> lock(tasksMutex);
+            tasks.emplace([packaged]() { (*packaged)(); });
+        }
+        available.notify_one();
+
+        return result;
+    }
+};
@@ -0,0 +1,114 @@
+#pragma once
+#include "Board.h"
+#include "MoveGen.h"
+#include <array>
+#include <cstdint>
+
+// the biggest board with a threat table, the table has 2 ^ cells entries and a bigger one is too much work for
+// the compiler
+constexpr int THREAT_TABLE_CELLS = 12;
+
+// WIN_CELLS of Threats, for every set of pieces of one player the cells that complete one of its lines
+template <typename Mask, int Cells, int LineCount>
+constexpr std::array<Mask, (Cells <= THREAT_TABLE_CELLS) ? (1 << Cells) : 1> makeWinCells(
+    const std::array<Mask, LineCount>& lines) {
+    std::array<Mask, (Cells <= THREAT_TABLE_CELLS) ? (1 << Cells) : 1> table{};
+
+    if (Cells > THREAT_TABLE_CELLS) {
+        return table;
+    }
+
+    for (uint32_t pieces = 0; pieces < table.size(); pieces++) {
+        for (Mask line : lines) {
+            Mask missing = line & ~Mask(pieces);
+
+            // a line with exactly one missing cell is completed by that cell
+            if (missing != 0 && (missing & (missing - 1)) == 0) {
+                table[pieces] |= missing;
+            }
+        }
+    }
+
+    return table;
+}
+
+// Threats finds the cells that matter for the lines of a player with mask operations only:
+// - a threat is an open cell that completes a line of K - 1 pieces of the player, for boards of at most
+//   THREAT_TABLE_CELLS cells it is read from a table indexed by the pieces of the player, for larger ones every
+//   line is checked
+// - an open line of n pieces is a line with n pieces of the player and none of the opponent, the open twos
+//   and threes of the bigger boards
+template <typename BoardType>
+class Threats {
+public:
+    using Mask = typename BoardType::Mask;
+
+    // the biggest board with a threat table
+    static constexpr int TABLE_CELLS = THREAT_TABLE_CELLS;
+
+    // the cells that complete a line for every set of pieces of a player, a single entry for larger boards
+    static constexpr std::array<Mask, (BoardType::CELLS <= TABLE_CELLS) ? (1 << BoardType::CELLS) : 1> WIN_CELLS =
+        makeWinCells<Mask, BoardType::CELLS, BoardType::LINE_COUNT>(BoardType::LINES);
+
+    // return the open cells that complete a line of the given pieces
+    static constexpr Mask winningCells(Mask pieces, Mask open) {
+        if constexpr (BoardType::CELLS <= TABLE_CELLS) {
+            return WIN_CELLS[pieces] & open;
+        }
+        else {
+            Mask cells = 0;
+
+            for (Mask line : BoardType::LINES) {
+                Mask missing = line & ~pieces;
+                if ((missing & open) == missing && missing != 0 && (missing & (missing - 1)) == 0) {
+                    cells |= missing;
+                }
+            }
+
+            return cells;
+        }
+    }
+
+    // return the open cells where the player wins at once
+    static constexpr Mask winningMoves(const BoardType& board, Player player) {
+        return winningCells(board.getMask(player), board.empty());
+    }
+
+    // return the open cells the player has to take or the opponent wins at once
+    static constexpr Mask blockingMoves(const BoardType& board, Player player) {
+        return winningCells(board.getMask((player == X) ? O : X), board.empty());
+    }
+
+    // return the number of lines with exactly the given number of pieces of the player and none of the opponent
+    static int countOpenLines(const BoardType& board, Player player, int pieces) {
+        Mask mine = board.getMask(player);
+        Mask theirs = board.getMask((player == X) ? O : X);
+        int count = 0;
+
+        for (Mask line : BoardType::LINES) {
+            if (!(line & theirs) && popCount(line & mine) == pieces) {
+                count++;
+            }
+        }
+
+        return count;
+    }
+
+    // return the open cells that give the player at least two threats at once, the opponent can't block both
+    static Mask forkMoves(const BoardType& board, Player player) {
+        Mask mine = board.getMask(player);
+        Mask open = board.empty();
+        Mask forks = 0;
+
+        for (Mask rest = open; rest; rest &= rest - 1) {
+            Mask cell = rest & (~rest + 1);
+            Mask threats = winningCells(mine | cell, open & ~cell);
+
+            if (threats & (threats - 1)) {
+                forks |= cell;
+            }
+        }
+
+        return forks;
+    }
+};
@@ -0,0 +1,79 @@
+#include "TranspositionTable.h"
+using namespace std;
+
+TranspositionTable::TranspositionTable(size_t megabytes) : age(0) {
+    resize(megabytes);
+}
+
+void TranspositionTable::resize(size_t megabytes) {
+    // the biggest power of two number of slots that fits the budget, with at least one slot
+    size_t count = 1;
+    while ((count * 2) * sizeof(Slot) <= megabytes * 1024 * 1024) {
+        count *= 2;
+    }
+
+    slots.reset(new Slot[count]);
+    slotCount = count;
+    indexMask = count - 1;
+    clear();
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i < slotCount; i++) {
+        slots[i].check.store(0, memory_order_relaxed);
+        slots[i].data.store(0, memory_order_relaxed);
+    }
+}
+
+void TranspositionTable::newSearch() {
+    age.fetch_add(1, memory_order_relaxed);
+}
+
+uint64_t TranspositionTable::pack(int score, int depth, Bound bound, int bestMove) const {
+    return uint64_t(uint16_t(int16_t(score)))
+        | (uint64_t(uint8_t(depth)) << 16)
+        | (uint64_t(uint8_t(bound)) << 24)
+        | (uint64_t(uint8_t(int8_t(bestMove))) << 32)
+        | (uint64_t(age.load(memory_order_relaxed)) << 40)
+        | (uint64_t(1) << 48); // marks the slot as used
+}
+
+bool TranspositionTable::probe(uint64_t key, TTEntry& entry) {
+    const Slot& slot = slots[key & indexMask];
+    uint64_t data = slot.data.load(memory_order_relaxed);
+    uint64_t check = slot.check.load(memory_order_relaxed);
+
+    // check if the slot holds this position and wasn't torn by another thread
+    if (data == 0 || (check ^ data) != key) {
+        return false;
+    }
+
+    entry.score = int16_t(data & 0xFFFF);
+    entry.depth = int((data >> 16) & 0xFF);
+    entry.bound = Bound((data >> 24) & 0xFF);
+    entry.bestMove = int8_t((data >> 32) & 0xFF);
+
+    return true;
+}
+
+bool TranspositionTable::store(uint64_t key, int score, int depth, Bound bound, int bestMove) {
+    Slot& slot = slots[key & indexMask];
+    uint64_t storedData = slot.data.load(memory_order_relaxed);
+    uint64_t storedKey = slot.check.load(memory_order_relaxed) ^ storedData;
+    int storedDepth = int((storedData >> 16) & 0xFF);
+    uint8_t storedAge = uint8_t((storedData >> 40) & 0xFF);
+
+    // keep the deeper entry of the current search when two positions share a slot
+    if (storedData != 0 && storedKey != key && storedAge == age.load(memory_order_relaxed) && storedDepth > depth) {
+        return false;
+    }
+
+    uint64_t data = pack(score, depth, bound, bestMove);
+    slot.check.store(key ^ data, memory_order_relaxed);
+    slot.data.store(data, memory_order_relaxed);
+    return true;
+}
+
+size_t TranspositionTable::size() const {
+    return slotCount;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Bound is one of Exact, LowerBound and UpperBound, it tells what a stored score means after alpha-beta
+// pruning, Exact is the real score, LowerBound means the real score is at least the stored one (a beta cutoff)
+// and UpperBound means it is at most the stored one (no move raised alpha)
+enum Bound {
+    Exact,
+    LowerBound,
+    UpperBound
+};
+
+// the unpacked content of one transposition table slot
+struct TTEntry {
+    int score; // the score of the position for the player to move, relative to the position
+    int depth; // the number of plies that were searched below the position
+    Bound bound; // what the score means
+    int bestMove; // the cell of the best move or -1 if there is none
+};
+
+// TranspositionTable remembers the result of searched positions by their zobrist hash so the same position
+// reached through a different move order isn't searched again, it has a fixed number of slots chosen from
+// the memory budget and every slot packs its entry into one 64-bit word next to the key
+//
+// the table can be shared by many search threads without locks: every slot stores the key xor the data, so
+// a slot torn by two threads writing at once no longer matches its key and is read as a miss. The table keeps
+// no counters, a shared counter written by every probe would make the threads fight over its cache line, so
+// every search counts its own hits and stores (see SearchCounters)
+class TranspositionTable {
+private:
+    // one slot of the table
+    struct Slot {
+        std::atomic<uint64_t> check; // the zobrist hash of the stored position xor the data
+        std::atomic<uint64_t> data; // the packed entry: score (16 bits), depth (8), bound (8), best move (8) and age (8)
+    };
+
+    std::unique_ptr<Slot[]> slots; // the slots of the table
+    size_t slotCount; // the number of slots, a power of two
+    uint64_t indexMask; // the mask that turns a key into a slot index
+    std::atomic<uint8_t> age; // the age of the current search, old entries are replaced first
+
+    // pack an entry and the current age into the data word of a slot
+    uint64_t pack(int score, int depth, Bound bound, int bestMove) const;
+
+public:
+    // constructor to initialize a table that uses at most the given number of megabytes
+    explicit TranspositionTable(size_t megabytes = 1);
+
+    // change the memory of the table to at most the given number of megabytes, the content is lost
+    void resize(size_t megabytes);
+
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+    // remove every entry
+    void clear();
+
+    // start a new search, the entries of the older searches can be replaced by any new entry
+    void newSearch();
+
+    // look for the position with the given key, return true and fill the entry if it is found
+    bool probe(uint64_t key, TTEntry& entry);
+
+    // store the result of a position and return true, it replaces the entry in its slot if the slot is empty,
+    // holds the same position, holds an entry of an older search or holds an entry searched less deep, otherwise
+    // the entry isn't stored and false is returned
+    bool store(uint64_t key, int score, int depth, Bound bound, int bestMove);
+
+    // return the number of slots
+    size_t size() const;
+};
@@ -1,15 +1,42 @@
+#include "BoardSizes.h"
 #include "Controller.h"
+#include <cstdlib>
 #include <iostream>
-#include <cstdlib> 
-#include <ctime>
 using namespace std;
 
-int main() {
-    srand(time(nullptr));
-    
-    Model game;
+// play a game of a human against the ai on the board
+template <typename BoardType>
+static void play() {
+    BasicModel<BoardType> game;
+
+    // the ai plays the move of its deepest completed search after at most one second, the hard ai never draws
+    // a random number so it isn't seeded
+    BasicAI<BoardType>* ai = new BasicAI<BoardType>(Hard);
+    ai->setTimeLimit(1000);
 
-    Controller gameController(new Human(), new AI(Hard));
+    BasicController<BoardType> gameController(new BasicHuman<BoardType>(), ai);
     
     gameController.go(game);
+}
+
+// TicTacToe [<rows> <cols> <k>], the classic 3x3 game without arguments
+int main(int argc, char* argv[]) {
+    if (argc != 1 && argc != 4) {
+        cerr << "usage: TicTacToe [<rows> <cols> <k>]" << endl;
+        return 1;
+    }
+
+    int rows = (argc == 4) ? atoi(argv[1]) : 3;
+    int cols = (argc == 4) ? atoi(argv[2]) : 3;
+    int k = (argc == 4) ? atoi(argv[3]) : 3;
+
+    bool supported = withBoardSize(rows, cols, k, [](auto board) {
+        play<decltype(board)>();
+    });
+    if (!supported) {
+        cerr << "unsupported board " << rows << "x" << cols << " with " << k << " in a row" << endl;
+        return 1;
+    }
+
+    return 0;
 }
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "BatchEvaluator.h"
+#include "Model.h"
+
+using Board3 = Board<3, 3, 3>;
+using Board4 = Board<4, 4, 3>;
+
+// return the packed form of every reachable 3x3 position that isn't over
+static std::vector<uint32_t> playablePositions() {
+    std::vector<uint32_t> positions;
+
+    for (uint32_t index = 0; index < Encoding<Board3>::indexCount(); index++) {
+        if (SOLVED_TABLE[index].bestCell >= 0) {
+            positions.push_back(Encoding<Board3>::pack(Encoding<Board3>::fromIndex(index)));
+        }
+    }
+
+    return positions;
+}
+
+// check if the solved table and the parallel search give the same values to every position
+TEST(BatchEvaluatorTest, SolvedTableMatchesSearch) {
+    // arrange
+    std::vector<uint32_t> positions = playablePositions();
+    TranspositionTable solvedTable(1);
+    TranspositionTable searchTable(4);
+    ThreadPool pool(4);
+    BatchEvaluator<Board3> solved(solvedTable, nullptr);
+    BatchEvaluator<Board3> search(searchTable, &pool);
+    search.setUseSolvedTable(false);
+
+    // action
+    std::vector<Evaluation> expected = solved.evaluate(positions);
+    std::vector<Evaluation> results = search.evaluate(positions);
+
+    // assert
+    ASSERT_EQ(results.size(), positions.size());
+    for (size_t i = 0; i < positions.size(); i++) {
+        Board3 board = Encoding<Board3>::unpack(positions[i]);
+        ASSERT_EQ(results[i].score, expected[i].score) << "position " << positions[i];
+        ASSERT_TRUE(board.empty() & Board3::bit(results[i].cell)) << "position " << positions[i];
+    }
+}
+
+// check if the results keep the order of the positions, duplicates included, and the positions aren't changed
+TEST(BatchEvaluatorTest, OrderAndDuplicates) {
+    // arrange
+    Board3 win;
+    win.place(0, X);
+    win.place(3, O);
+    win.place(1, X);
+    win.place(4, O);
+    std::vector<Board3> boards = { win, Board3(), win, Board3() };
+    std::vector<Board3> copies = boards;
+    TranspositionTable table(1);
+    ThreadPool pool(2);
+    BatchEvaluator<Board3> evaluator(table, &pool);
+
+    // action
+    std::vector<Evaluation> results = evaluator.evaluate(boards);
+
+    // assert
+    EXPECT_EQ(results[0].cell, 2);
+    EXPECT_EQ(results[0].score, WIN_SCORE - 1);
+    EXPECT_EQ(results[1].score, 0);
+    EXPECT_EQ(results[2].cell, results[0].cell);
+    EXPECT_EQ(results[3].cell, results[1].cell);
+    EXPECT_EQ(boards, copies);
+}
+
+// check if finished and illegal positions have no move
+TEST(BatchEvaluatorTest, FinishedAndIllegal) {
+    // arrange
+    Board3 won;
+    won.place(0, X);
+    won.place(3, O);
+    won.place(1, X);
+    won.place(4, O);
+    won.place(2, X);
+    uint32_t illegal = Encoding<Board3>::pack(Board3::fromMasks(0b111, 0b111));
+    TranspositionTable table(1);
+    BatchEvaluator<Board3> evaluator(table, nullptr);
+
+    // action
+    std::vector<Evaluation> results = evaluator.evaluate(std::vector<uint32_t>{ Encoding<Board3>::pack(won), illegal });
+
+    // assert
+    EXPECT_EQ(results[0].cell, -1);
+    EXPECT_EQ(results[0].score, -WIN_SCORE);
+    EXPECT_TRUE(results[0].legal);
+    EXPECT_EQ(results[1].cell, -1);
+    EXPECT_EQ(results[1].score, 0);
+    EXPECT_FALSE(results[1].legal);
+}
+
+// check if a batch of larger boards is searched within the limits
+TEST(BatchEvaluatorTest, LargerBoardLimits) {
+    // arrange
+    std::vector<Board4> boards(8);
+    for (int i = 0; i < 8; i++) {
+        boards[i].place(i, X);
+    }
+    TranspositionTable table(4);
+    ThreadPool pool(4);
+    SearchLimits limits;
+    limits.nodes = 20000;
+    BatchEvaluator<Board4> evaluator(table, &pool, limits);
+
+    // action
+    std::vector<Evaluation> results = evaluator.evaluate(boards);
+
+    // assert
+    for (size_t i = 0; i < boards.size(); i++) {
+        EXPECT_TRUE(boards[i].empty() & Board4::bit(results[i].cell));
+    }
+}
+
+// check if packed halves that share a cell are illegal, unpacking alone would give the cell to X
+TEST(BatchEvaluatorTest, OverlappingHalvesAreIllegal) {
+    // arrange
+    uint32_t overlap = 1u | (1u << Encoding<Board3>::PACKED_SHIFT);
+    TranspositionTable table(1);
+    BatchEvaluator<Board3> evaluator(table, nullptr);
+
+    // action
+    std::vector<Evaluation> results = evaluator.evaluate(std::vector<uint32_t>{ overlap });
+
+    // assert
+    EXPECT_FALSE(results[0].legal);
+    EXPECT_EQ(results[0].cell, -1);
+}
+
+// check if a winner with the piece count of the other player and two winners are illegal
+TEST(BatchEvaluatorTest, WinnerParityIsChecked) {
+    // arrange
+    // X won on the top row and O moved after it
+    uint32_t xWonThenO = Encoding<Board3>::pack(Board3::fromMasks(0b000000111, 0b001011000));
+    // O won on the middle row and X moved after it
+    uint32_t oWonThenX = Encoding<Board3>::pack(Board3::fromMasks(0b101000011, 0b000111000));
+    // both players have a line
+    uint32_t bothWon = Encoding<Board3>::pack(Board3::fromMasks(0b000000111, 0b000111000));
+    TranspositionTable table(1);
+    BatchEvaluator<Board3> evaluator(table, nullptr);
+
+    // action
+    std::vector<Evaluation> results = evaluator.evaluate(std::vector<uint32_t>{ xWonThenO, oWonThenX, bothWon });
+
+    // assert
+    for (const Evaluation& result : results) {
+        EXPECT_FALSE(result.legal);
+        EXPECT_EQ(result.cell, -1);
+    }
+}
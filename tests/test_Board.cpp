@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "Board.h"
+#include "BoardSizes.h"
+
+// the win lines are generated at compile time
+static_assert(Board<3, 3, 3>::LINE_COUNT == 8, "3x3 has 8 winning lines");
+static_assert(Board<3, 3, 3>::LINES[0] == 0b000000111, "the first line is the top row");
+
+// check if every size has the right number of winning lines
+TEST(BoardTest, LineCounts) {
+    // assert
+    EXPECT_EQ((Board<4, 4, 4>::LINE_COUNT), 10);
+    EXPECT_EQ((Board<5, 5, 4>::LINE_COUNT), 28);
+    EXPECT_EQ((Board<7, 7, 5>::LINE_COUNT), 60);
+    EXPECT_EQ((Board<3, 5, 3>::LINE_COUNT), 20);
+}
+
+// check if the masks use the smallest integer that fits the board
+TEST(BoardTest, MaskWidth) {
+    // assert
+    EXPECT_EQ(sizeof(Board<4, 4, 4>::Mask), 4u);
+    EXPECT_EQ(sizeof(Board<7, 7, 5>::Mask), 8u);
+    EXPECT_EQ((Board<7, 7, 5>::FULL), (uint64_t(1) << 49) - 1);
+}
+
+// check if a board of 32 cells fills its whole 32-bit mask
+TEST(BoardTest, FullMaskOf32Cells) {
+    // arrange
+    using Board32 = Board<4, 8, 4>;
+    Board32 board;
+
+    // action
+    for (int cell = 0; cell < Board32::CELLS; cell++) {
+        board.place(cell, (cell % 2 == 0) ? X : O);
+    }
+
+    // assert
+    EXPECT_EQ(sizeof(Board32::Mask), 4u);
+    EXPECT_EQ(Board32::FULL, 0xFFFFFFFFu);
+    EXPECT_EQ((Board<8, 8, 5>::FULL), ~uint64_t(0));
+    EXPECT_TRUE(board.isFull());
+    EXPECT_EQ(board.empty(), 0u);
+    EXPECT_EQ(board.occupied(), Board32::FULL);
+}
+
+// check if a row win is detected on a bigger board
+TEST(BoardTest, RowWinOnBigBoard) {
+    // arrange
+    Board<5, 5, 4> board;
+
+    for (int col = 1; col < 4; col++) {
+        board.place(board.index(2, col), X);
+    }
+
+    // assert
+    EXPECT_FALSE(board.hasWin(X));
+
+    // action
+    board.place(board.index(2, 4), X);
+
+    // assert
+    EXPECT_TRUE(board.hasWin(X));
+    EXPECT_FALSE(board.hasWin(O));
+}
+
+// check if an anti-diagonal win is detected on a bigger board
+TEST(BoardTest, AntiDiagonalWinOnBigBoard) {
+    // arrange
+    Board<7, 7, 5> board;
+
+    for (int i = 0; i < 5; i++) {
+        board.place(board.index(1 + i, 6 - i), O);
+    }
+
+    // assert
+    EXPECT_TRUE(board.hasWin(O));
+    EXPECT_EQ(board.getCell(board.index(3, 4)), OCell);
+}
+
+// check if removing a piece opens the cell again
+TEST(BoardTest, RemoveCell) {
+    // arrange
+    Board<4, 4, 3> board;
+    board.place(5, X);
+
+    // action
+    board.remove(5);
+
+    // assert
+    EXPECT_EQ(board.getCell(5), Open);
+    EXPECT_EQ(board.empty(), (Board<4, 4, 3>::FULL));
+}
+
+// check if the lines through a cell are found for the center and the corner
+TEST(BoardTest, CellLines) {
+    // assert
+    EXPECT_EQ((Board<3, 3, 3>::CELL_LINES[4].count), 4);
+    EXPECT_EQ((Board<3, 3, 3>::CELL_LINES[0].count), 3);
+    EXPECT_EQ((Board<3, 3, 3>::CELL_LINES[1].count), 2);
+    EXPECT_EQ((Board<5, 5, 4>::CELL_LINES[12].count), 8);
+}
+
+// check if the win is only reported through the cell that completes it
+TEST(BoardTest, WinAtLastCell) {
+    // arrange
+    Board<4, 4, 3> board;
+    board.place(board.index(1, 1), X);
+    board.place(board.index(2, 2), X);
+    board.place(board.index(3, 3), X);
+
+    // assert
+    EXPECT_TRUE(board.isWinAt(board.index(3, 3), X));
+    EXPECT_FALSE(board.isWinAt(board.index(0, 3), X));
+    EXPECT_EQ(board.moveCount(), 3);
+}
+
+// check if every supported size visits its board and the others are refused
+TEST(BoardTest, WithBoardSize) {
+    // arrange
+    int cells = 0;
+    int winLength = 0;
+    auto visit = [&](auto board) {
+        cells = decltype(board)::CELLS;
+        winLength = decltype(board)::WIN_LENGTH;
+    };
+
+    // action
+    bool fiveByFive = withBoardSize(5, 5, 4, visit);
+    int fiveByFiveCells = cells;
+    bool unsupported = withBoardSize(5, 5, 5, visit);
+
+    // assert
+    EXPECT_TRUE(fiveByFive);
+    EXPECT_EQ(fiveByFiveCells, 25);
+    EXPECT_EQ(winLength, 4);
+    EXPECT_FALSE(unsupported);
+    EXPECT_EQ(cells, 25);
+}
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include "Encoding.h"
+#include "Model.h"
+
+using Board3 = Board<3, 3, 3>;
+using Encoding3 = Encoding<Board3>;
+
+// the base-3 index of 3x3 is dense and the packed form is 32 bits
+static_assert(Encoding3::indexCount() == 19683, "3x3 has 3^9 indices");
+static_assert(sizeof(Encoding3::Packed) == 4, "3x3 packs in 32 bits");
+
+// check if the index gives every cell its base-3 digit
+TEST(EncodingTest, IndexDigits) {
+    // arrange
+    Board3 board;
+    board.place(0, X);
+    board.place(8, O);
+
+    // assert
+    EXPECT_EQ(Encoding3::index(Board3()), 0u);
+    EXPECT_EQ(Encoding3::index(board), 1u + 2u * 6561u);
+}
+
+// check if every index decodes back to itself
+TEST(EncodingTest, IndexRoundTrip) {
+    for (uint64_t index = 0; index < Encoding3::indexCount(); index++) {
+        // assert
+        ASSERT_EQ(Encoding3::index(Encoding3::fromIndex(index)), index);
+    }
+}
+
+// check if the packed form decodes back to the same board
+TEST(EncodingTest, PackRoundTrip) {
+    // arrange
+    using Encoding4 = Encoding<Board<4, 4, 4>>;
+    Board<4, 4, 4> board;
+    board.place(0, X);
+    board.place(15, O);
+    board.place(7, X);
+
+    // action
+    auto packed = Encoding4::pack(board);
+
+    // assert
+    EXPECT_EQ(packed, (1u | (1u << 7) | (1u << 31)));
+    EXPECT_EQ(Encoding4::unpack(packed), board);
+    EXPECT_EQ(Encoding4::unpack(packed).hash(), board.hash());
+}
+
+// check if the model exposes the encodings of its position
+TEST(EncodingTest, ModelEncoding) {
+    // arrange
+    Model game;
+    game.play(1, 1);
+
+    // assert
+    EXPECT_EQ(game.encode(), 81u);
+    EXPECT_EQ(game.pack(), 1u << 4);
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "Evaluator.h"
+#include "Random.h"
+#include "Search.h"
+#include <type_traits>
+
+using Board3 = Board<3, 3, 3>;
+using Board7 = Board<7, 7, 5>;
+
+// return the score of the board for X by checking every line, a complete line is worth nothing
+template <typename BoardType>
+static int scoreByLines(const BoardType& board) {
+    const int weights[] = { 0, 1, 4, 16, 64 };
+    int score = 0;
+
+    for (typename BoardType::Mask line : BoardType::LINES) {
+        int xCount = popCount(board.getXMask() & line);
+        int oCount = popCount(board.getOMask() & line);
+        if (oCount == 0 && xCount < BoardType::WIN_LENGTH) {
+            score += weights[xCount];
+        }
+        if (xCount == 0 && oCount < BoardType::WIN_LENGTH) {
+            score -= weights[oCount];
+        }
+    }
+
+    return score;
+}
+
+// play random games and check the running score against scoring every line after every move and undo
+template <typename BoardType>
+static void checkRandomGames(uint64_t seed) {
+    Random random(seed);
+
+    for (int game = 0; game < 20; game++) {
+        BoardType board;
+        LineEvaluator<BoardType> evaluator;
+        int moves = static_cast<int>(random.below(BoardType::CELLS - 1)) + 1;
+
+        for (int i = 0; i < moves; i++) {
+            // action
+            int cell = nthBit(board.empty(), static_cast<int>(random.below(BoardType::CELLS - board.moveCount())));
+            Player side = board.sideToMove();
+            board.place(cell, side);
+            evaluator.place(cell, side);
+
+            // assert
+            ASSERT_EQ(evaluator.evaluate(X), scoreByLines(board));
+            ASSERT_EQ(evaluator.evaluate(O), -scoreByLines(board));
+            ASSERT_EQ(evaluator.scoreLines(), scoreByLines(board));
+
+            // a removed piece gives back the score before it
+            board.remove(cell);
+            evaluator.remove(cell, side);
+            ASSERT_EQ(evaluator.evaluate(X), scoreByLines(board));
+            board.place(cell, side);
+            evaluator.place(cell, side);
+        }
+
+        // a reset to the same board gives the same score
+        LineEvaluator<BoardType> fresh;
+        fresh.reset(board);
+        EXPECT_EQ(fresh.evaluate(X), evaluator.evaluate(X));
+    }
+}
+
+// check if the incremental score of the 3x3 board is the score of every line
+TEST(EvaluatorTest, IncrementalMatchesLines3) {
+    checkRandomGames<Board3>(3);
+}
+
+// check if the incremental score of the 7x7 board (four blocks of 16 lines) is the score of every line
+TEST(EvaluatorTest, IncrementalMatchesLines7) {
+    checkRandomGames<Board7>(7);
+}
+
+// check if the lines blocked by the opponent are worth nothing
+TEST(EvaluatorTest, BlockedLines) {
+    // arrange
+    Board3 board;
+    board.place(4, X);
+    board.place(0, O);
+    LineEvaluator<Board3> evaluator;
+
+    // action
+    evaluator.reset(board);
+
+    // assert
+    // X has 4 lines through the center, the diagonal is blocked, O has its row and column
+    EXPECT_EQ(evaluator.evaluate(X), 3 - 2);
+}
+
+// check if a depth-limited search on a big board plays the cell with the most open lines
+TEST(EvaluatorTest, DepthLimitedSearchPrefersCenter) {
+    // arrange
+    TranspositionTable table(1);
+    Search<Board7> search(table);
+    Board7 board;
+
+    // action
+    Search<Board7>::Result result = search.searchRoot(board, 1, board.empty());
+
+    // assert
+    EXPECT_EQ(result.cell, 3 * Board7::COLS + 3);
+    EXPECT_GT(result.score, 0);
+    EXPECT_LT(result.score, WIN_THRESHOLD);
+}
+
+// check if the zero evaluator keeps the old draw score at the depth limit
+TEST(EvaluatorTest, ZeroEvaluator) {
+    // arrange
+    TranspositionTable table(1);
+    Search<Board7, ZeroEvaluator<Board7>> search(table);
+    Board7 board;
+
+    // action
+    Search<Board7, ZeroEvaluator<Board7>>::Result result = search.searchRoot(board, 2, board.empty());
+
+    // assert
+    EXPECT_EQ(result.score, 0);
+}
+
+// check if only the searches that can stop before the end of the game follow the moves with the line evaluator
+TEST(EvaluatorTest, DefaultEvaluator) {
+    // assert
+    EXPECT_TRUE((std::is_same<Search<Board3>::EvaluatorType, ZeroEvaluator<Board3>>::value));
+    EXPECT_TRUE((std::is_same<Search<Board7>::EvaluatorType, LineEvaluator<Board7>>::value));
+    EXPECT_TRUE((std::is_same<Search<Board<4, 4, 4>>::EvaluatorType, LineEvaluator<Board<4, 4, 4>>>::value));
+}
+
+// check if a search that reaches the end of the game with the line evaluator finds the same score as without
+TEST(EvaluatorTest, FullDepthIgnoresEvaluator) {
+    // arrange
+    TranspositionTable lineTable(1);
+    TranspositionTable zeroTable(1);
+    Search<Board3, LineEvaluator<Board3>> line(lineTable);
+    Search<Board3, ZeroEvaluator<Board3>> zero(zeroTable);
+    Board3 board;
+    board.place(0, X);
+
+    // action
+    int lineScore = line.searchRoot(board, Board3::CELLS - 1, board.empty()).score;
+    int zeroScore = zero.searchRoot(board, Board3::CELLS - 1, board.empty()).score;
+
+    // assert
+    EXPECT_EQ(lineScore, zeroScore);
+    EXPECT_EQ(lineScore, 0);
+}
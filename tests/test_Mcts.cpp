@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include "Mcts.h"
+
+using Board3 = Board<3, 3, 3>;
+using Board7 = Board<7, 7, 5>;
+
+// check if the search takes an immediate win on a large board
+TEST(MctsTest, TakesWin) {
+    // arrange
+    Board7 board;
+    Mcts<Board7> mcts(1 << 16, 1);
+    SearchLimits limits;
+    limits.nodes = 5000;
+
+    board.place(0, X);
+    board.place(7, O);
+    board.place(1, X);
+    board.place(8, O);
+    board.place(2, X);
+    board.place(9, O);
+    board.place(3, X);
+    board.place(10, O);
+
+    // action
+    Mcts<Board7>::Result result = mcts.search(board, limits);
+
+    // assert
+    EXPECT_EQ(result.cell, 4);
+    EXPECT_GT(result.value, 0.9);
+}
+
+// check if the search blocks the only winning move of the opponent
+TEST(MctsTest, BlocksWin) {
+    // arrange
+    Board3 board;
+    Mcts<Board3> mcts(1 << 16, 1);
+    SearchLimits limits;
+    limits.nodes = 20000;
+
+    board.place(0, X);
+    board.place(4, O);
+    board.place(1, X);
+
+    // action
+    Mcts<Board3>::Result result = mcts.search(board, limits);
+
+    // assert
+    EXPECT_EQ(result.cell, 2);
+}
+
+// check if the search runs exactly the given number of playouts and counts their speed
+TEST(MctsTest, PlayoutBudget) {
+    // arrange
+    Board7 board;
+    Mcts<Board7> mcts(1 << 16, 1);
+    SearchLimits limits;
+    limits.nodes = 3000;
+
+    // action
+    mcts.search(board, limits);
+
+    // assert
+    EXPECT_EQ(mcts.getPlayouts(), 3000u);
+    EXPECT_EQ(mcts.getRootVisits(), 3000u);
+    EXPECT_GT(mcts.getPlayoutsPerSecond(), 0.0);
+}
+
+// check if the arena never grows past its capacity
+TEST(MctsTest, ArenaCapacity) {
+    // arrange
+    Board7 board;
+    Mcts<Board7> mcts(1000, 1);
+    SearchLimits limits;
+    limits.nodes = 5000;
+
+    // action
+    Mcts<Board7>::Result result = mcts.search(board, limits);
+
+    // assert
+    EXPECT_GE(result.cell, 0);
+    EXPECT_LE(mcts.getNodeCount(), mcts.getCapacity());
+    EXPECT_EQ(mcts.getCapacity(), 1000);
+}
+
+// check if the tree below the played moves is kept for the next search
+TEST(MctsTest, TreeReuse) {
+    // arrange
+    Board7 board;
+    Mcts<Board7> mcts(1 << 16, 1);
+    SearchLimits limits;
+    limits.nodes = 5000;
+
+    Mcts<Board7>::Result first = mcts.search(board, limits);
+    board.place(first.cell, X);
+    board.place((first.cell == 0) ? 1 : 0, O);
+
+    // action
+    mcts.search(board, limits);
+
+    // assert
+    EXPECT_GT(mcts.getRootVisits(), 5000u);
+}
+
+// check if a position that doesn't follow the tree starts a new one
+TEST(MctsTest, NewTreeForOtherPosition) {
+    // arrange
+    Board7 board;
+    Board7 other;
+    Mcts<Board7> mcts(1 << 16, 1);
+    SearchLimits limits;
+    limits.nodes = 2000;
+
+    board.place(24, X);
+    other.place(0, X);
+    mcts.search(board, limits);
+
+    // action
+    mcts.search(other, limits);
+
+    // assert
+    EXPECT_EQ(mcts.getRootVisits(), 2000u);
+}
+
+// check if the same seed gives the same move
+TEST(MctsTest, SeedDeterministic) {
+    // arrange
+    Board7 board;
+    Mcts<Board7> first(1 << 16, 42);
+    Mcts<Board7> second(1 << 16, 42);
+    SearchLimits limits;
+    limits.nodes = 2000;
+
+    // action
+    Mcts<Board7>::Result a = first.search(board, limits);
+    Mcts<Board7>::Result b = second.search(board, limits);
+
+    // assert
+    EXPECT_EQ(a.cell, b.cell);
+    EXPECT_EQ(a.visits, b.visits);
+}
+
+// check if batched playouts count every game and still find the win
+TEST(MctsTest, BatchPlayouts) {
+    // arrange
+    Board7 board;
+    Mcts<Board7> mcts(1 << 16, 1);
+    SearchLimits limits;
+    limits.nodes = 32 * 200;
+    mcts.setBatchSize(32);
+
+    board.place(0, X);
+    board.place(7, O);
+    board.place(1, X);
+    board.place(8, O);
+    board.place(2, X);
+    board.place(9, O);
+    board.place(3, X);
+    board.place(10, O);
+
+    // action
+    Mcts<Board7>::Result result = mcts.search(board, limits);
+
+    // assert
+    EXPECT_EQ(result.cell, 4);
+    EXPECT_EQ(mcts.getPlayouts(), 32u * 200u);
+    EXPECT_EQ(mcts.getRootVisits(), 32u * 200u);
+}
+
+// check if a set stop flag ends the search after the first playout
+TEST(MctsTest, StopFlag) {
+    // arrange
+    Board7 board;
+    Mcts<Board7> mcts(1 << 16, 1);
+    std::atomic<bool> stop(true);
+    mcts.setStopFlag(&stop);
+
+    // action
+    Mcts<Board7>::Result result = mcts.search(board, SearchLimits());
+
+    // assert
+    EXPECT_EQ(mcts.getPlayouts(), 1u);
+    EXPECT_GE(result.cell, 0);
+}
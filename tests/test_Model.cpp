@@ -462,3 +462,192 @@ TEST(ModelTest, UndoStatus) {
     // assert
     EXPECT_EQ(game.getStatus(), Playing);
 }
+
+// check if the masks follow the played cells
+TEST(ModelTest, MasksFollowMoves) {
+    // arrange
+    Model game;
+
+    game.play(0, 0);
+    game.updateStatus();
+    game.play(2, 1);
+    game.updateStatus();
+
+    // assert
+    EXPECT_EQ(game.getXMask(), 0b000000001);
+    EXPECT_EQ(game.getOMask(), 0b010000000);
+}
+
+// check if every winning line is detected from its mask
+TEST(ModelTest, WinMasks) {
+    // assert
+    for (auto line : Model::BoardType::LINES) {
+        EXPECT_TRUE(Model::BoardType::isWinMask(line));
+    }
+    EXPECT_FALSE(Model::BoardType::isWinMask(0b010001110));
+}
+
+// check if play updates the status by itself
+TEST(ModelTest, PlayUpdatesStatus) {
+    // arrange
+    Model game;
+
+    game.play(0, 0);
+    game.play(1, 0);
+    game.play(0, 1);
+    game.play(1, 1);
+
+    // action
+    game.play(0, 2);
+
+    // assert
+    EXPECT_EQ(game.getStatus(), Win);
+    EXPECT_EQ(game.getWinner(), X);
+}
+
+// check if the hash only depends on the position and not on the move order
+TEST(ModelTest, HashTransposition) {
+    // arrange
+    Model first;
+    Model second;
+
+    first.play(0, 0);
+    first.play(2, 2);
+    first.play(1, 1);
+    second.play(1, 1);
+    second.play(2, 2);
+    second.play(0, 0);
+
+    // assert
+    EXPECT_EQ(first.hash(), second.hash());
+    EXPECT_NE(first.hash(), Model().hash());
+}
+
+// check if undo brings the hash back
+TEST(ModelTest, HashUndo) {
+    // arrange
+    Model game;
+    game.play(0, 0);
+    uint64_t before = game.hash();
+
+    // action
+    game.play(1, 2);
+    game.undo(1, 2);
+
+    // assert
+    EXPECT_EQ(game.hash(), before);
+}
+
+// check if tryPlay reports why a move is refused without throwing
+TEST(ModelTest, TryPlayResults) {
+    // arrange
+    Model game;
+
+    // assert
+    EXPECT_EQ(game.tryPlay(3, 0), OutOfBounds);
+    EXPECT_EQ(game.tryPlay(0, 0), Played);
+    EXPECT_EQ(game.tryPlay(0, 0), CellTaken);
+    EXPECT_EQ(game.sideToMove(), O);
+}
+
+// check if tryPlay refuses moves after the game is over
+TEST(ModelTest, TryPlayAfterGameOver) {
+    // arrange
+    Model game;
+
+    game.playUnchecked(0);
+    game.playUnchecked(3);
+    game.playUnchecked(1);
+    game.playUnchecked(4);
+    game.playUnchecked(2);
+
+    // assert
+    EXPECT_EQ(game.getStatus(), Win);
+    EXPECT_EQ(game.tryPlay(2, 2), GameOver);
+    EXPECT_THROW(game.play(2, 2), IllegalStateException);
+}
+
+// check if undo without coordinates restores the position and the status
+TEST(ModelTest, UndoLastMove) {
+    // arrange
+    Model game;
+
+    game.play(0, 0);
+    game.play(1, 0);
+    game.play(0, 1);
+    game.play(1, 1);
+    game.play(0, 2);
+
+    // action
+    bool undone = game.undo();
+
+    // assert
+    EXPECT_TRUE(undone);
+    EXPECT_EQ(game.getStatus(), Playing);
+    EXPECT_EQ(game.getCell(0, 2), Open);
+    EXPECT_EQ(game.moveCount(), 4);
+    EXPECT_EQ(game.lastMove().row, 1);
+    EXPECT_EQ(game.lastMove().column, 1);
+    EXPECT_EQ(game.whoIsNext(), X);
+}
+
+// check if redo plays the undone moves again and a new move drops them
+TEST(ModelTest, RedoMoves) {
+    // arrange
+    Model game;
+
+    game.play(0, 0);
+    game.play(1, 0);
+    game.play(0, 1);
+    game.play(1, 1);
+    game.play(0, 2);
+    game.undo();
+    game.undo();
+
+    // action
+    bool redone = game.redo() && game.redo();
+
+    // assert
+    EXPECT_TRUE(redone);
+    EXPECT_EQ(game.getStatus(), Win);
+    EXPECT_FALSE(game.redo());
+
+    // action
+    game.undo();
+    game.play(2, 2);
+
+    // assert
+    EXPECT_FALSE(game.canRedo());
+}
+
+// check if there is nothing to undo at the start
+TEST(ModelTest, UndoAtStart) {
+    // arrange
+    Model game;
+
+    // assert
+    EXPECT_FALSE(game.undo());
+    EXPECT_EQ(game.lastMove().row, -1);
+    EXPECT_THROW(game.undo(0, 0), IllegalCellException);
+}
+
+// check if a game on a bigger board is only won by a full line of its length
+TEST(ModelTest, BiggerBoardGame) {
+    // arrange
+    BasicModel<Board<5, 5, 4>> game;
+
+    // action
+    for (int column = 0; column < 3; column++) {
+        game.play(0, column);
+        game.play(4, column);
+    }
+    Status beforeFourth = game.getStatus();
+    game.play(0, 3);
+
+    // assert
+    EXPECT_EQ(beforeFourth, Playing);
+    EXPECT_EQ(game.getStatus(), Win);
+    EXPECT_EQ(game.getWinner(), X);
+    EXPECT_EQ(game.getGrid().size(), 5u);
+    EXPECT_THROW(game.play(3, 0), IllegalStateException);
+}
@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+#include "MoveGen.h"
+
+// check if the bit helpers count and find the set bits
+TEST(MoveGenTest, BitHelpers) {
+    // arrange
+    uint64_t mask = 0b101100100;
+
+    // assert
+    EXPECT_EQ(popCount(mask), 4);
+    EXPECT_EQ(lowestBit(mask), 2);
+    EXPECT_EQ(nthBit(mask, 0), 2);
+    EXPECT_EQ(nthBit(mask, 3), 8);
+    EXPECT_EQ(popCount(uint64_t(1) << 63), 1);
+    EXPECT_EQ(lowestBit(uint64_t(1) << 63), 63);
+}
+
+// check if the move list has one move for every open cell in order
+TEST(MoveGenTest, ListFromMask) {
+    // arrange
+    MoveList<9> moves(0b100010011);
+
+    // assert
+    ASSERT_EQ(moves.size(), 4);
+    EXPECT_EQ(moves[0], 0);
+    EXPECT_EQ(moves[1], 1);
+    EXPECT_EQ(moves[2], 4);
+    EXPECT_EQ(moves[3], 8);
+}
+
+// check if an empty mask gives an empty list
+TEST(MoveGenTest, EmptyList) {
+    // arrange
+    MoveList<9> moves(0);
+
+    // assert
+    EXPECT_TRUE(moves.empty());
+    EXPECT_EQ(moves.begin(), moves.end());
+}
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include "OpeningBook.h"
+#include "PlayerType.h"
+#include "Model.h"
+#include <fstream>
+#include <thread>
+
+using Board3 = Board<3, 3, 3>;
+using Board4 = Board<4, 4, 4>;
+
+// return a path for a test file
+static std::string bookPath(const std::string& name) {
+    return ::testing::TempDir() + name;
+}
+
+// check if the written entries are found sorted by key and then by score
+TEST(OpeningBookTest, WriteAndFind) {
+    // arrange
+    std::vector<BookEntry> entries = {
+        BookEntry{ 30, 5, 1, 4, 0 },
+        BookEntry{ 10, 0, 2, 4, 0 },
+        BookEntry{ 30, 9, 3, 4, 0 },
+    };
+    std::string path = bookPath("find.book");
+    OpeningBook book;
+
+    // action
+    bool written = OpeningBook::write(path, 3, 3, 3, entries);
+    bool opened = book.open(path);
+    size_t count = 0;
+    const BookEntry* found = book.find(30, count);
+    size_t missingCount = 0;
+    const BookEntry* missing = book.find(20, missingCount);
+
+    // assert
+    EXPECT_TRUE(written);
+    EXPECT_TRUE(opened);
+    EXPECT_EQ(book.size(), 3u);
+    EXPECT_TRUE(book.matches(3, 3, 3));
+    EXPECT_FALSE(book.matches(4, 4, 4));
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(count, 2u);
+    EXPECT_EQ(found[0].cell, 3);
+    EXPECT_EQ(found[1].cell, 1);
+    EXPECT_EQ(missing, nullptr);
+    EXPECT_EQ(missingCount, 0u);
+}
+
+// check if a file that isn't a book is refused
+TEST(OpeningBookTest, RejectsOtherFiles) {
+    // arrange
+    std::string path = bookPath("text.book");
+    std::ofstream(path) << "not an opening book, just some text in a file";
+    OpeningBook book;
+
+    // action
+    bool opened = book.open(path);
+    bool missing = book.open(bookPath("missing.book"));
+
+    // assert
+    EXPECT_FALSE(opened);
+    EXPECT_FALSE(missing);
+    EXPECT_FALSE(book.isOpen());
+    EXPECT_EQ(book.bestCell(Board3()), -1);
+}
+
+// check if the book of the 3x3 openings gives moves as good as the search for every symmetric position
+TEST(OpeningBookTest, BuildAndLookupSymmetric) {
+    // arrange
+    TranspositionTable table(1);
+    std::vector<BookEntry> entries = buildOpeningBook<Board3>(2, SearchLimits(), table);
+    std::string path = bookPath("openings3.book");
+    OpeningBook::write(path, 3, 3, 3, entries);
+    OpeningBook book;
+    ASSERT_TRUE(book.open(path));
+
+    for (int first = 0; first < Board3::CELLS; first++) {
+        Board3 board;
+        board.place(first, X);
+
+        // action
+        int score = 1;
+        int cell = book.bestCell(board, &score);
+
+        // assert
+        ASSERT_GE(cell, 0) << "first move " << first;
+        EXPECT_TRUE(board.empty() & Board3::bit(cell)) << "first move " << first;
+        EXPECT_EQ(score, 0) << "first move " << first;
+
+        board.place(cell, O);
+        Search<Board3> search(table);
+        EXPECT_EQ(search.searchRoot(board, Board3::CELLS, board.empty()).score, 0) << "first move " << first;
+    }
+}
+
+// check if a book of another board size isn't used
+TEST(OpeningBookTest, OtherBoardSize) {
+    // arrange
+    TranspositionTable table(1);
+    SearchLimits limits;
+    limits.nodes = 2000;
+    std::string path = bookPath("openings4.book");
+    OpeningBook::write(path, 4, 4, 4, buildOpeningBook<Board4>(0, limits, table));
+    OpeningBook book;
+    book.open(path);
+
+    // action
+    int other = book.bestCell(Board3());
+    int same = book.bestCell(Board4());
+
+    // assert
+    EXPECT_EQ(other, -1);
+    EXPECT_GE(same, 0);
+}
+
+// check if the ai plays the book move before searching
+TEST(OpeningBookTest, AIPlaysBookMove) {
+    // arrange
+    std::vector<BookEntry> entries = { BookEntry{ Board3().hash(), 0, 4, 9, 0 } };
+    std::string path = bookPath("center.book");
+    OpeningBook::write(path, 3, 3, 3, entries);
+    Model game;
+    AI ai(Hard);
+    ai.setUseSolvedTable(false);
+
+    // action
+    bool loaded = ai.loadOpeningBook(path);
+    ai.play(X, game, -1, -1);
+
+    // assert
+    EXPECT_TRUE(loaded);
+    EXPECT_EQ(game.getCell(1, 1), XCell);
+    EXPECT_EQ(ai.getLastStats().tableStores, 0u);
+}
+
+// check if the ai refuses a book of another board size and keeps playing without it
+TEST(OpeningBookTest, AIRefusesOtherBoardSize) {
+    // arrange
+    TranspositionTable table(1);
+    SearchLimits limits;
+    limits.nodes = 2000;
+    std::string path = bookPath("openings4ai.book");
+    OpeningBook::write(path, 4, 4, 4, buildOpeningBook<Board4>(0, limits, table));
+    Model game;
+    AI ai(MonteCarlo);
+    ai.setNodeLimit(200);
+
+    // action
+    bool loaded = ai.loadOpeningBook(path);
+    ai.play(X, game, -1, -1);
+
+    // assert
+    EXPECT_FALSE(loaded);
+    EXPECT_GE(ai.getLastStats().nodes, 200u);
+}
+
+// check if the replies the book knows aren't pondered
+TEST(OpeningBookTest, PonderSkipsBookReplies) {
+    // arrange
+    Model game;
+    game.play(1, 1);
+    Model corner = game;
+    corner.play(0, 0);
+    Model edge = game;
+    edge.play(0, 1);
+    uint64_t key = Symmetry<Board3>::canonical(corner.getBoard()).board.hash();
+    std::string path = bookPath("corner.book");
+    OpeningBook::write(path, 3, 3, 3, { BookEntry{ key, 0, 1, 9, 0 } });
+    AI ai(Hard);
+    ai.setUseSolvedTable(false);
+    ai.loadOpeningBook(path);
+
+    // action
+    ai.ponder(game);
+    while (ai.isPondering()) {
+        std::this_thread::yield();
+    }
+
+    // assert
+    EXPECT_FALSE(ai.hasPonderedReply(corner));
+    EXPECT_TRUE(ai.hasPonderedReply(edge));
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "ParallelSearch.h"
+#include "Encoding.h"
+#include "SolvedTable.h"
+#include <thread>
+
+using Board3 = Board<3, 3, 3>;
+using Board7 = Board<7, 7, 5>;
+
+// check if root split gives the score of the serial search for every reachable 3x3 position
+TEST(ParallelSearchTest, RootSplitMatchesSerial) {
+    // arrange
+    ThreadPool pool(4);
+    TranspositionTable serialTable(1);
+    TranspositionTable parallelTable(1);
+    int positions = 0;
+
+    for (uint32_t index = 0; index < Encoding<Board3>::indexCount(); index++) {
+        if (SOLVED_TABLE[index].bestCell < 0) {
+            continue;
+        }
+
+        Board3 board = Encoding<Board3>::fromIndex(index);
+        int maxDepth = Board3::CELLS - board.moveCount();
+        Search<Board3> serial(serialTable);
+        ParallelSearch<Board3> parallel(parallelTable, pool);
+
+        // action
+        Search<Board3>::Result expected = serial.iterativeDeepening(board, maxDepth, board.empty(), SearchLimits());
+        Search<Board3>::Result result = parallel.iterativeDeepening(board, maxDepth, board.empty(), SearchLimits());
+
+        // assert
+        ASSERT_EQ(result.score, expected.score) << "index " << index;
+        ASSERT_TRUE(board.empty() & Board3::bit(result.cell)) << "index " << index;
+        positions++;
+    }
+
+    EXPECT_GT(positions, 0);
+}
+
+// check if root split keeps the lower cell of equal scores so its move doesn't depend on the timing
+TEST(ParallelSearchTest, RootSplitDeterministic) {
+    // arrange
+    Board3 board;
+    ThreadPool pool(4);
+    TranspositionTable first(1);
+    TranspositionTable second(1);
+
+    // action
+    Search<Board3>::Result a = ParallelSearch<Board3>(first, pool).iterativeDeepening(board, Board3::CELLS, board.empty(), SearchLimits());
+    Search<Board3>::Result b = ParallelSearch<Board3>(second, pool).iterativeDeepening(board, Board3::CELLS, board.empty(), SearchLimits());
+
+    // assert
+    EXPECT_EQ(a.cell, 0);
+    EXPECT_EQ(a.score, 0);
+    EXPECT_EQ(a.cell, b.cell);
+}
+
+// check if lazy smp finds a move within a node budget and stops its helpers
+TEST(ParallelSearchTest, LazySmpNodeBudget) {
+    // arrange
+    Board7 board;
+    ThreadPool pool(4);
+    TranspositionTable table(4);
+    ParallelSearch<Board7> search(table, pool);
+    SearchLimits limits;
+    limits.nodes = 80000;
+
+    // action
+    Search<Board7>::Result result = search.iterativeDeepening(board, Board7::CELLS, board.empty(), limits);
+
+    // assert
+    EXPECT_GE(result.cell, 0);
+    EXPECT_GE(search.getCompletedDepth(), 1);
+    EXPECT_GT(search.getNodes(), 0u);
+    EXPECT_EQ(board, Board7());
+}
+
+// check if lazy smp with a single worker gives the move of the serial search
+TEST(ParallelSearchTest, LazySmpSingleWorkerMatchesSerial) {
+    // arrange
+    Board7 board;
+    board.place(24, X);
+    board.place(25, O);
+    ThreadPool pool(1);
+    TranspositionTable parallelTable(4);
+    TranspositionTable serialTable(4);
+    ParallelSearch<Board7> parallel(parallelTable, pool);
+    Search<Board7> serial(serialTable);
+    Board7 copy = board;
+
+    // action
+    Search<Board7>::Result result = parallel.iterativeDeepening(board, 3, board.empty(), SearchLimits());
+    Search<Board7>::Result expected = serial.iterativeDeepening(copy, 3, copy.empty(), SearchLimits());
+
+    // assert
+    EXPECT_EQ(result.cell, expected.cell);
+    EXPECT_EQ(result.score, expected.score);
+    EXPECT_EQ(parallel.getNodes(), serial.getNodes());
+}
+
+// check if lazy smp takes the quickest win on a large board
+TEST(ParallelSearchTest, LazySmpQuickWin) {
+    // arrange
+    Board7 board;
+    ThreadPool pool(3);
+    TranspositionTable table(4);
+    ParallelSearch<Board7> search(table, pool);
+    SearchLimits limits;
+    limits.milliseconds = 200;
+
+    board.place(0, X);
+    board.place(7, O);
+    board.place(1, X);
+    board.place(8, O);
+    board.place(2, X);
+    board.place(9, O);
+    board.place(3, X);
+    board.place(10, O);
+
+    // action
+    Search<Board7>::Result result = search.iterativeDeepening(board, Board7::CELLS - board.moveCount(), board.empty(), limits);
+
+    // assert
+    EXPECT_EQ(result.cell, 4);
+    EXPECT_EQ(result.score, WIN_SCORE - 1);
+}
+
+// check if a cancel flag stops the helpers and the calling thread
+TEST(ParallelSearchTest, LazySmpStopFlag) {
+    // arrange
+    Board7 board;
+    ThreadPool pool(4);
+    TranspositionTable table(4);
+    ParallelSearch<Board7> search(table, pool);
+    std::atomic<bool> stop(false);
+    search.setStopFlag(&stop);
+    std::thread canceller([&stop]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        stop = true;
+    });
+    auto start = std::chrono::steady_clock::now();
+
+    // action
+    Search<Board7>::Result result = search.iterativeDeepening(board, Board7::CELLS, board.empty(), SearchLimits());
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    canceller.join();
+
+    // assert
+    EXPECT_GE(result.cell, 0);
+    EXPECT_LT(elapsed.count(), 1000);
+}
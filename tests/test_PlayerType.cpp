@@ -2,6 +2,7 @@
 #include <array>
 #include "PlayerType.h"
 #include "Model.h"
+#include "SolvedTable.h"
 
 // check if X can play in open cell
 TEST(HumanPlay, XPlayInOpenCell) {
@@ -234,3 +235,382 @@ TEST(AIPlay, EasyPlay) {
     // assert
     EXPECT_EQ(notEmpty, 1);
 }
+
+// play every reachable position and check if the search chooses a move as good as the solved table's
+static void compareSolvedWithSearch(Model& game, AI& solved, AI& search, int& positions) {
+    if (game.isTheGameOver()) {
+        return;
+    }
+
+    Model fromTable = game;
+    Model fromSearch = game;
+    solved.play(game.sideToMove(), fromTable, -1, -1);
+    search.play(game.sideToMove(), fromSearch, -1, -1);
+    ASSERT_EQ(SOLVED_TABLE[fromTable.encode()].score, SOLVED_TABLE[fromSearch.encode()].score);
+    positions++;
+
+    for (int cell = 0; cell < Model::BoardType::CELLS; cell++) {
+        if (game.getBoard().empty() & Model::BoardType::bit(cell)) {
+            game.playUnchecked(cell);
+            compareSolvedWithSearch(game, solved, search, positions);
+            game.undo();
+        }
+    }
+}
+
+// check if the Hard AI search plays optimal moves like the solved table
+TEST(AIPlay, HardSolvedTableMatchesSearch) {
+    // arrange
+    Model game;
+    AI solved(Hard);
+    AI search(Hard);
+    int positions = 0;
+    search.setUseSolvedTable(false);
+
+    // action
+    compareSolvedWithSearch(game, solved, search, positions);
+
+    // assert
+    EXPECT_GT(positions, 0);
+}
+
+// check if the hard ai with many threads draws against the solved game after every first move
+TEST(AIPlay, HardThreadsDrawSolvedTable) {
+    // arrange
+    AI solved(Hard);
+    AI search(Hard);
+    search.setUseSolvedTable(false);
+    search.setThreads(4);
+
+    for (int first = 0; first < Model::BoardType::CELLS; first++) {
+        Model game;
+        game.playUnchecked(first);
+
+        // action
+        while (!game.isTheGameOver()) {
+            AI& next = (game.sideToMove() == O) ? search : solved;
+            next.play(game.sideToMove(), game, -1, -1);
+        }
+
+        // assert
+        EXPECT_EQ(game.getStatus(), Draw) << "first move " << first;
+    }
+
+    EXPECT_EQ(search.getThreads(), 4);
+}
+
+// check if the monte carlo ai plays a legal move and counts its playouts
+TEST(AIPlay, MonteCarloPlay) {
+    // arrange
+    Model game;
+    AI ai(MonteCarlo);
+    ai.setNodeLimit(2000);
+
+    // action
+    ai.play(X, game, -1, -1);
+
+    // assert
+    EXPECT_EQ(game.moveCount(), 1);
+    EXPECT_EQ(ai.getDifficulty(), MonteCarlo);
+    EXPECT_GT(ai.getPlayoutsPerSecond(), 0.0);
+}
+
+// check if the monte carlo ai takes an immediate win
+TEST(AIPlay, MonteCarloWin) {
+    // arrange
+    Model game;
+    AI ai(MonteCarlo);
+    ai.setNodeLimit(5000);
+
+    game.play(0, 0);
+    game.play(1, 0);
+    game.play(0, 1);
+    game.play(1, 1);
+
+    // action
+    ai.play(X, game, -1, -1);
+
+    // assert
+    EXPECT_EQ(game.getStatus(), Win);
+    EXPECT_EQ(game.getWinner(), X);
+}
+
+// check if the ai evaluates a batch of positions without playing them
+TEST(AIPlay, EvaluateBatch) {
+    // arrange
+    Model game;
+    Model win;
+    AI ai(Hard);
+    ai.setThreads(2);
+    win.play(0, 0);
+    win.play(1, 0);
+    win.play(0, 1);
+    win.play(1, 1);
+
+    // action
+    std::vector<Evaluation> results = ai.evaluate({ game.pack(), win.pack() });
+
+    // assert
+    EXPECT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].score, 0);
+    EXPECT_EQ(results[1].cell, 2);
+    EXPECT_EQ(game.moveCount(), 0);
+    EXPECT_EQ(win.moveCount(), 4);
+}
+
+// check if the move of a pondered position is played from the pondered replies
+TEST(AIPlay, PonderedReply) {
+    // arrange
+    Model game;
+    AI ai(Hard);
+    ai.setUseSolvedTable(false);
+    game.play(1, 1);
+    game.play(0, 0);
+
+    ai.ponder(game);
+    while (ai.isPondering()) {
+        std::this_thread::yield();
+    }
+    game.play(2, 2);
+
+    // action
+    ai.play(O, game, -1, -1);
+
+    // assert
+    EXPECT_EQ(ai.getPonderHits(), 1u);
+    EXPECT_EQ(game.moveCount(), 4);
+    EXPECT_EQ(SOLVED_TABLE[game.encode()].score, 0);
+}
+
+// check if a pondered position is reported ready before the move is played
+TEST(AIPlay, HasPonderedReply) {
+    // arrange
+    Model game;
+    AI ai(Hard);
+    ai.setUseSolvedTable(false);
+    game.play(1, 1);
+
+    // action
+    ai.ponder(game);
+    while (ai.isPondering()) {
+        std::this_thread::yield();
+    }
+    Model pondered = game;
+    pondered.play(0, 0);
+    bool ready = ai.hasPonderedReply(pondered);
+    bool stale = ai.hasPonderedReply(game);
+
+    // assert
+    EXPECT_TRUE(ready);
+    EXPECT_FALSE(stale);
+}
+
+// check if playing stops the pondering at once and still searches the move
+TEST(AIPlay, PlayStopsPondering) {
+    // arrange
+    Model game;
+    AI ai(Hard);
+    ai.setUseSolvedTable(false);
+
+    ai.ponder(game);
+    game.play(1, 1);
+
+    // action
+    ai.play(O, game, -1, -1);
+
+    // assert
+    EXPECT_FALSE(ai.isPondering());
+    EXPECT_EQ(game.moveCount(), 2);
+    EXPECT_EQ(SOLVED_TABLE[game.encode()].score, 0);
+}
+
+// check if the solved table ai doesn't ponder
+TEST(AIPlay, SolvedTableDoesNotPonder) {
+    // arrange
+    Model game;
+    AI ai(Hard);
+
+    // action
+    ai.ponder(game);
+
+    // assert
+    EXPECT_FALSE(ai.isPondering());
+}
+
+// check if the hard ai of a board without a solved table ponders with the table left on
+TEST(AIPlay, BiggerBoardPonders) {
+    // arrange
+    BasicModel<Board<4, 4, 4>> game;
+    BasicAI<Board<4, 4, 4>> ai(Hard);
+    ai.setTimeLimit(10);
+    game.play(1, 1);
+
+    // action
+    ai.ponder(game);
+    while (ai.isPondering()) {
+        std::this_thread::yield();
+    }
+    game.play(2, 2);
+
+    // assert
+    EXPECT_TRUE(ai.hasPonderedReply(game));
+}
+
+// check if the ai chooses its move without changing the model
+TEST(AIPlay, ChooseMoveKeepsModel) {
+    // arrange
+    Model game;
+    AI ai(Hard);
+    CancelToken token;
+    game.play(0, 0);
+    game.play(1, 0);
+    game.play(0, 1);
+    game.play(1, 1);
+
+    // action
+    int cell = ai.chooseMove(game, token);
+
+    // assert
+    EXPECT_EQ(cell, 2);
+    EXPECT_EQ(game.moveCount(), 4);
+}
+
+// check if a cancelled token gives no move
+TEST(AIPlay, ChooseMoveCancelled) {
+    // arrange
+    Model game;
+    AI ai(Hard);
+    CancelToken token;
+    CancelToken copy = token;
+    ai.setUseSolvedTable(false);
+
+    // action
+    copy.cancel();
+    int cell = ai.chooseMove(game, token);
+
+    // assert
+    EXPECT_TRUE(token.isCancelled());
+    EXPECT_EQ(cell, -1);
+    EXPECT_EQ(game.moveCount(), 0);
+}
+
+// check if two easy ai with the same seed play the same game and another seed another one
+TEST(AIPlay, EasySeeded) {
+    // arrange
+    Model first;
+    Model second;
+    Model other;
+    AI a(Easy);
+    AI b(Easy);
+    AI c(Easy);
+    a.setSeed(11);
+    b.setSeed(11);
+    c.setSeed(12);
+
+    // action
+    for (int i = 0; i < 5; i++) {
+        a.play(first.sideToMove(), first, -1, -1);
+        b.play(second.sideToMove(), second, -1, -1);
+        c.play(other.sideToMove(), other, -1, -1);
+    }
+
+    // assert
+    EXPECT_EQ(a.getSeed(), 11u);
+    EXPECT_EQ(first.getXMask(), second.getXMask());
+    EXPECT_EQ(first.getOMask(), second.getOMask());
+    EXPECT_TRUE(first.getXMask() != other.getXMask() || first.getOMask() != other.getOMask());
+}
+
+// check if the hard ai plays the move proven by the solver without searching
+TEST(AIPlay, ProvenMove) {
+    // arrange
+    Model game;
+    for (int cell : { 0, 3, 1, 4 }) {
+        game.playUnchecked(cell);
+    }
+    AI ai(Hard);
+    ai.setUseSolvedTable(false);
+    ai.setProofNodeLimit(10000);
+
+    // action
+    ai.play(X, game, -1, -1);
+
+    // assert
+    EXPECT_EQ(game.getCell(0, 2), XCell);
+    EXPECT_EQ(ai.getLastStats().tableStores, 0u);
+}
+
+// check if the stats of every move are kept and added up until they are reset
+TEST(AIPlay, SearchStats) {
+    // arrange
+    Model game;
+    AI ai(Hard);
+    ai.setUseSolvedTable(false);
+
+    // action
+    ai.play(X, game, -1, -1);
+    SearchStats first = ai.getLastStats();
+    ai.play(O, game, -1, -1);
+    SearchStats second = ai.getLastStats();
+    SearchStats total = ai.getTotalStats();
+
+    // assert
+    EXPECT_EQ(first.moves, 1u);
+    EXPECT_GT(first.nodes, second.nodes);
+    EXPECT_GT(first.tableStores, 0u);
+    EXPECT_GE(first.seconds, 0.0);
+    EXPECT_EQ(total.moves, 2u);
+    EXPECT_EQ(total.nodes, first.nodes + second.nodes);
+    EXPECT_EQ(total.tableHits, first.tableHits + second.tableHits);
+    EXPECT_EQ(total.maxDepth, std::max(first.maxDepth, second.maxDepth));
+#if defined(TICTACTOE_SEARCH_STATS)
+    EXPECT_GT(first.cutoffs, 0u);
+    EXPECT_GT(first.maxDepth, 0);
+#endif
+
+    ai.resetStats();
+    EXPECT_EQ(ai.getTotalStats().moves, 0u);
+    EXPECT_EQ(ai.getLastStats().moves, 1u);
+}
+
+// check if a move that doesn't search has no nodes
+TEST(AIPlay, SolvedTableStats) {
+    // arrange
+    Model game;
+    AI ai(Hard);
+
+    // action
+    ai.play(X, game, -1, -1);
+
+    // assert
+    EXPECT_EQ(ai.getLastStats().moves, 1u);
+    EXPECT_EQ(ai.getLastStats().nodes, 0u);
+    EXPECT_EQ(ai.getLastStats().tableStores, 0u);
+}
+
+// check if the ais of a bigger board win at once and block the line of the opponent
+TEST(AIPlay, BiggerBoard) {
+    // arrange
+    BasicModel<Board<7, 7, 5>> win;
+    BasicModel<Board<7, 7, 5>> block;
+    for (int column = 0; column < 4; column++) {
+        win.play(3, column);
+        win.play(6, column);
+        block.play(6, 6 - column);
+        if (column < 3) {
+            block.play(3, column);
+        }
+    }
+    BasicAI<Board<7, 7, 5>> hard(Hard);
+    hard.setTimeLimit(200);
+    BasicAI<Board<7, 7, 5>> normal(Normal);
+
+    // action
+    hard.play(X, win, -1, -1);
+    normal.play(O, block, -1, -1);
+
+    // assert
+    EXPECT_EQ(win.getStatus(), Win);
+    EXPECT_EQ(win.getCell(3, 4), XCell);
+    EXPECT_EQ(block.getCell(6, 2), OCell);
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "ProofSearch.h"
+#include "Encoding.h"
+#include "SolvedTable.h"
+
+using Board3 = Board<3, 3, 3>;
+using Board4 = Board<4, 4, 4>;
+using Board5 = Board<5, 5, 4>;
+
+// check if the solver proves the value of every reachable 3x3 position and a move that keeps it
+TEST(ProofSearchTest, MatchesSolvedTable) {
+    ProofSearch<Board3> solver(1);
+
+    for (uint32_t index = 0; index < Encoding<Board3>::indexCount(); index++) {
+        // arrange
+        const SolvedEntry& entry = SOLVED_TABLE[index];
+        if (entry.bestCell < 0) {
+            continue;
+        }
+        Board3 board = Encoding<Board3>::fromIndex(index);
+        ProofResult expected = (entry.score > 0) ? ProvenWin : (entry.score < 0) ? ProvenLoss : ProvenDraw;
+
+        // action
+        ProofSearch<Board3>::Result result = solver.solve(board);
+
+        // assert
+        ASSERT_EQ(result.result, expected) << "index " << index;
+        ASSERT_GE(result.cell, 0) << "index " << index;
+        ASSERT_TRUE(board.empty() & Board3::bit(result.cell)) << "index " << index;
+        if (expected != ProvenLoss) {
+            board.place(result.cell, board.sideToMove());
+            int8_t reply = SOLVED_TABLE[static_cast<uint32_t>(Encoding<Board3>::index(board))].score;
+            EXPECT_EQ(reply < 0, expected == ProvenWin) << "index " << index;
+            EXPECT_EQ(reply == 0, expected == ProvenDraw) << "index " << index;
+        }
+    }
+}
+
+// check if the proof and disproof numbers of a proven win are 0 and infinite
+TEST(ProofSearchTest, ProvenWinNumbers) {
+    // arrange
+    Board4 board;
+    for (int cell : { 0, 4, 1, 5, 2, 6 }) {
+        board.place(cell, board.sideToMove());
+    }
+    ProofSearch<Board4> solver(1);
+
+    // action
+    ProofSearch<Board4>::Result result = solver.solve(board);
+
+    // assert
+    EXPECT_EQ(result.result, ProvenWin);
+    EXPECT_EQ(result.cell, 3);
+    EXPECT_EQ(result.proof, 0u);
+    EXPECT_EQ(result.disproof, ProofSearch<Board4>::INFINITE_PROOF);
+}
+
+// check if the solver stops at its node limit and reports the numbers it reached
+TEST(ProofSearchTest, NodeLimit) {
+    // arrange
+    SearchLimits limits;
+    limits.nodes = 2000;
+    ProofSearch<Board5> solver(1);
+
+    // action
+    ProofSearch<Board5>::Result result = solver.solve(Board5(), limits);
+
+    // assert
+    EXPECT_EQ(result.result, Unproven);
+    EXPECT_EQ(result.cell, -1);
+    EXPECT_LE(result.nodes, limits.nodes);
+    EXPECT_EQ(result.nodes, solver.getNodes());
+    EXPECT_GT(result.proof, 0u);
+    EXPECT_GT(result.disproof, 0u);
+    EXPECT_LT(result.proof, ProofSearch<Board5>::INFINITE_PROOF);
+}
+
+// check if a game that is over is solved without expanding it
+TEST(ProofSearchTest, GameOver) {
+    // arrange
+    Board3 board;
+    for (int cell : { 0, 3, 1, 4, 2 }) {
+        board.place(cell, board.sideToMove());
+    }
+    ProofSearch<Board3> solver(1);
+
+    // action
+    ProofSearch<Board3>::Result result = solver.solve(board);
+
+    // assert
+    EXPECT_EQ(result.result, ProvenLoss);
+    EXPECT_EQ(result.cell, -1);
+    EXPECT_EQ(result.nodes, 0u);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "Random.h"
+#include <array>
+#include <thread>
+
+// check if the same seed gives the same numbers and another seed other ones
+TEST(RandomTest, Seeded) {
+    // arrange
+    Random first(42);
+    Random second(42);
+    Random other(43);
+    int same = 0;
+
+    // action
+    for (int i = 0; i < 100; i++) {
+        uint64_t value = first.next();
+        EXPECT_EQ(value, second.next());
+        same += (value == other.next());
+    }
+
+    // assert
+    EXPECT_EQ(same, 0);
+}
+
+// check if seeding again restarts the numbers
+TEST(RandomTest, ReseedRestarts) {
+    // arrange
+    Random random(7);
+    uint64_t first = random.next();
+    random.next();
+
+    // action
+    random.seed(7);
+
+    // assert
+    EXPECT_EQ(random.next(), first);
+}
+
+// check if the bounded numbers stay below the bound and hit every value about as often
+TEST(RandomTest, BelowIsUniform) {
+    // arrange
+    Random random(1);
+    std::array<int, 7> counts{};
+    const int draws = 70000;
+
+    // action
+    for (int i = 0; i < draws; i++) {
+        uint32_t value = random.below(7);
+        ASSERT_LT(value, 7u);
+        counts[value]++;
+    }
+
+    // assert
+    for (int count : counts) {
+        EXPECT_NEAR(count, draws / 7, draws / 70);
+    }
+}
+
+// check if a bound of one always gives zero
+TEST(RandomTest, BelowOne) {
+    // arrange
+    Random random(3);
+
+    // assert
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(random.below(1), 0u);
+    }
+}
+
+// check if the streams of one seed are different and reproducible
+TEST(RandomTest, Streams) {
+    // arrange
+    Random first = Random::stream(5, 1);
+    Random again = Random::stream(5, 1);
+    Random base = Random::stream(5, 0);
+    Random jumped(5);
+    jumped.jump();
+
+    // action
+    uint64_t value = first.next();
+
+    // assert
+    EXPECT_EQ(value, again.next());
+    EXPECT_EQ(value, jumped.next());
+    EXPECT_NE(value, base.next());
+}
+
+// check if every thread gets its own generator
+TEST(RandomTest, LocalPerThread) {
+    // arrange
+    uint64_t mainValue = Random::local().next();
+    uint64_t threadValue = 0;
+
+    // action
+    std::thread worker([&threadValue]() { threadValue = Random::local().next(); });
+    worker.join();
+
+    // assert
+    EXPECT_NE(mainValue, threadValue);
+}
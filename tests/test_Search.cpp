@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+#include "Search.h"
+#include "Symmetry.h"
+#include <thread>
+
+using Board3 = Board<3, 3, 3>;
+using Board7 = Board<7, 7, 5>;
+
+// check if the empty 3x3 board is a draw
+TEST(SearchTest, EmptyBoardIsDraw) {
+    // arrange
+    Board3 board;
+    TranspositionTable table(1);
+    Search<Board3> search(table);
+
+    // action
+    Search<Board3>::Result result = search.searchRoot(board, Board3::CELLS, board.empty());
+
+    // assert
+    EXPECT_EQ(result.score, 0);
+    EXPECT_EQ(board, Board3());
+}
+
+// check if the search prefers the quickest win
+TEST(SearchTest, QuickestWin) {
+    // arrange
+    Board3 board;
+    TranspositionTable table(1);
+    Search<Board3> search(table);
+
+    board.place(0, X);
+    board.place(3, O);
+    board.place(1, X);
+    board.place(4, O);
+
+    // action
+    Search<Board3>::Result result = search.searchRoot(board, Board3::CELLS - board.moveCount(), board.empty());
+
+    // assert
+    EXPECT_EQ(result.cell, 2);
+    EXPECT_EQ(result.score, WIN_SCORE - 1);
+}
+
+// check if a perturbed move order still finds the quickest win
+TEST(SearchTest, PerturbedOrder) {
+    // arrange
+    Board3 board;
+    TranspositionTable table(1);
+    Search<Board3> search(table);
+
+    board.place(0, X);
+    board.place(3, O);
+    board.place(1, X);
+    board.place(4, O);
+    search.perturbOrder(3);
+
+    // action
+    Search<Board3>::Result result = search.searchRoot(board, Board3::CELLS - board.moveCount(), board.empty());
+
+    // assert
+    EXPECT_EQ(result.cell, 2);
+    EXPECT_EQ(result.score, WIN_SCORE - 1);
+}
+
+// check if the search blocks on a bigger board
+TEST(SearchTest, BlockOnBigBoard) {
+    // arrange
+    Board<4, 4, 3> board;
+    TranspositionTable table(1);
+    Search<Board<4, 4, 3>> search(table);
+
+    board.place(board.index(0, 0), X);
+    board.place(board.index(3, 3), O);
+    board.place(board.index(0, 1), X);
+
+    // action
+    Search<Board<4, 4, 3>>::Result result = search.searchRoot(board, 3, board.empty());
+
+    // assert
+    EXPECT_EQ(result.cell, board.index(0, 2));
+}
+
+// check if the ordering and the table keep the search small
+TEST(SearchTest, FewerNodesWithTable) {
+    // arrange
+    Board3 board;
+    TranspositionTable table(1);
+    Search<Board3> search(table);
+
+    // action
+    search.searchRoot(board, Board3::CELLS, Symmetry<Board3>::uniqueMoves(board));
+
+    // assert
+    EXPECT_LT(search.getNodes(), 5000u);
+}
+
+// check if iterative deepening searches to the end without limits
+TEST(SearchTest, DeepeningWithoutLimits) {
+    // arrange
+    Board3 board;
+    TranspositionTable table(1);
+    Search<Board3> search(table);
+
+    // action
+    Search<Board3>::Result result = search.iterativeDeepening(board, Board3::CELLS, board.empty(), SearchLimits());
+
+    // assert
+    EXPECT_EQ(search.getCompletedDepth(), Board3::CELLS);
+    EXPECT_FALSE(search.wasStopped());
+    EXPECT_EQ(result.score, 0);
+}
+
+// check if a node budget stops the search and still gives a move of a completed depth
+TEST(SearchTest, DeepeningNodeBudget) {
+    // arrange
+    Board7 board;
+    TranspositionTable table(1);
+    Search<Board7> search(table);
+    SearchLimits limits;
+    limits.nodes = 20000;
+
+    // action
+    Search<Board7>::Result result = search.iterativeDeepening(board, Board7::CELLS, board.empty(), limits);
+
+    // assert
+    EXPECT_TRUE(search.wasStopped());
+    EXPECT_GE(search.getCompletedDepth(), 1);
+    EXPECT_LT(search.getCompletedDepth(), Board7::CELLS);
+    EXPECT_GE(result.cell, 0);
+    EXPECT_EQ(board, Board7());
+}
+
+// check if a time budget keeps the search around its deadline
+TEST(SearchTest, DeepeningTimeBudget) {
+    // arrange
+    Board7 board;
+    TranspositionTable table(1);
+    Search<Board7> search(table);
+    SearchLimits limits;
+    limits.milliseconds = 50;
+    auto start = std::chrono::steady_clock::now();
+
+    // action
+    Search<Board7>::Result result = search.iterativeDeepening(board, Board7::CELLS, board.empty(), limits);
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+    // assert
+    EXPECT_GE(result.cell, 0);
+    EXPECT_LT(elapsed.count(), 1000);
+}
+
+// check if a flag set by another thread stops the search at once
+TEST(SearchTest, StopFlag) {
+    // arrange
+    Board7 board;
+    TranspositionTable table(1);
+    Search<Board7> search(table);
+    std::atomic<bool> stop(false);
+    search.setStopFlag(&stop);
+    std::thread canceller([&stop]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        stop = true;
+    });
+    auto start = std::chrono::steady_clock::now();
+
+    // action
+    Search<Board7>::Result result = search.iterativeDeepening(board, Board7::CELLS, board.empty(), SearchLimits());
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    canceller.join();
+
+    // assert
+    EXPECT_TRUE(search.wasStopped());
+    EXPECT_GE(result.cell, 0);
+    EXPECT_LT(elapsed.count(), 1000);
+}
+
+// check if the counters of a search add up and the cutoffs and depth are counted when the stats are on
+TEST(SearchTest, Counters) {
+    // arrange
+    TranspositionTable table(1);
+    Search<Board3> search(table);
+    Board3 board;
+
+    // action
+    search.iterativeDeepening(board, Board3::CELLS, board.empty(), SearchLimits());
+    SearchCounters counters = search.getCounters();
+    SearchCounters total;
+    total.add(counters);
+    total.add(counters);
+
+    // assert
+    EXPECT_EQ(counters.nodes, search.getNodes());
+    EXPECT_EQ(total.nodes, 2 * counters.nodes);
+    EXPECT_EQ(total.maxPly, counters.maxPly);
+    EXPECT_GT(counters.tableStores, 0u);
+    EXPECT_GT(counters.tableHits, 0u);
+    EXPECT_EQ(total.tableStores, 2 * counters.tableStores);
+#if defined(TICTACTOE_SEARCH_STATS)
+    EXPECT_GT(counters.cutoffs, 0u);
+    EXPECT_LT(counters.cutoffs, counters.nodes);
+    EXPECT_GT(counters.maxPly, 0);
+    EXPECT_LE(counters.maxPly, Board3::CELLS);
+#else
+    EXPECT_EQ(counters.cutoffs, 0u);
+    EXPECT_EQ(counters.maxPly, 0);
+#endif
+}
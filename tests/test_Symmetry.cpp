@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "Symmetry.h"
+
+using Board3 = Board<3, 3, 3>;
+using Symmetry3 = Symmetry<Board3>;
+
+// check if every transform is undone by its inverse
+TEST(SymmetryTest, InverseUndoesTransform) {
+    // arrange
+    Board3 board;
+    board.place(1, X);
+    board.place(5, O);
+    board.place(6, X);
+
+    for (int t = 0; t < Symmetry3::COUNT; t++) {
+        // action
+        Board3 back = Symmetry3::transform(Symmetry3::transform(board, t), Symmetry3::inverse(t));
+
+        // assert
+        EXPECT_EQ(back.getXMask(), board.getXMask());
+        EXPECT_EQ(back.getOMask(), board.getOMask());
+        EXPECT_EQ(back.hash(), board.hash());
+    }
+}
+
+// check if all the corner openings share one canonical position
+TEST(SymmetryTest, CornersShareCanonical) {
+    // arrange
+    const int corners[4] = { 0, 2, 6, 8 };
+    Board3 first;
+    first.place(corners[0], X);
+
+    for (int corner : corners) {
+        Board3 board;
+        board.place(corner, X);
+
+        // action
+        Symmetry3::Canonical canonical = Symmetry3::canonical(board);
+
+        // assert
+        EXPECT_EQ(canonical.board, Symmetry3::canonical(first).board);
+        EXPECT_EQ(Symmetry3::transform(board, canonical.transform), canonical.board);
+    }
+}
+
+// check if a move maps back to the real orientation
+TEST(SymmetryTest, MoveRoundTrip) {
+    for (int t = 0; t < Symmetry3::COUNT; t++) {
+        // action
+        Move move = Symmetry3::transformMove(Symmetry3::transformMove(Move{ 0, 1 }, t), Symmetry3::inverse(t));
+
+        // assert
+        EXPECT_EQ(move.row, 0);
+        EXPECT_EQ(move.column, 1);
+    }
+}
+
+// check if the empty board only has 3 different moves (corner, edge and center)
+TEST(SymmetryTest, UniqueMovesOnEmptyBoard) {
+    // arrange
+    Board3 board;
+
+    // assert
+    EXPECT_EQ(Symmetry3::uniqueMoves(board), Board3::bit(0) | Board3::bit(1) | Board3::bit(4));
+}
+
+// check if rectangles only use their 4 symmetries
+TEST(SymmetryTest, RectangleSymmetries) {
+    // arrange
+    Board<3, 5, 3> board;
+    board.place(0, X);
+
+    // assert
+    EXPECT_EQ((Symmetry<Board<3, 5, 3>>::COUNT), 4);
+    EXPECT_EQ((Symmetry<Board<3, 5, 3>>::canonical(board).board), board);
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include "ThreadPool.h"
+#include <atomic>
+#include <future>
+#include <vector>
+
+// check if the pool has at least one worker
+TEST(ThreadPoolTest, Size) {
+    // arrange
+    ThreadPool pool(3);
+    ThreadPool empty(0);
+
+    // assert
+    EXPECT_EQ(pool.size(), 3);
+    EXPECT_EQ(empty.size(), 1);
+}
+
+// check if every submitted task runs and gives its result
+TEST(ThreadPoolTest, SubmitResults) {
+    // arrange
+    ThreadPool pool(4);
+    std::vector<std::future<int>> results;
+
+    // action
+    for (int i = 0; i < 100; i++) {
+        results.push_back(pool.submit([i]() { return i * i; }));
+    }
+
+    // assert
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(results[i].get(), i * i);
+    }
+}
+
+// check if the waiting tasks are finished when the pool is destroyed
+TEST(ThreadPoolTest, DestructorFinishesTasks) {
+    // arrange
+    std::atomic<int> count(0);
+
+    // action
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 50; i++) {
+            pool.submit([&count]() { count++; });
+        }
+    }
+
+    // assert
+    EXPECT_EQ(count, 50);
+}
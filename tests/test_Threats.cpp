@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include "Threats.h"
+
+using Board3 = Board<3, 3, 3>;
+using Board7 = Board<7, 7, 5>;
+
+// check if the cells found for every set of pieces agree with placing every open cell and testing its lines
+template <typename BoardType>
+static void checkEveryPieceSet() {
+    for (uint32_t pieces = 0; pieces < (1u << BoardType::CELLS); pieces++) {
+        // arrange
+        typename BoardType::Mask expected = 0;
+        for (int cell = 0; cell < BoardType::CELLS; cell++) {
+            if (pieces & BoardType::bit(cell)) {
+                continue;
+            }
+            for (int i = 0; i < BoardType::CELL_LINES[cell].count; i++) {
+                typename BoardType::Mask line = BoardType::CELL_LINES[cell].lines[i];
+                if (((pieces | BoardType::bit(cell)) & line) == line) {
+                    expected |= BoardType::bit(cell);
+                }
+            }
+        }
+
+        // action
+        typename BoardType::Mask cells = Threats<BoardType>::winningCells(pieces, BoardType::FULL & ~pieces);
+
+        // assert
+        ASSERT_EQ(cells, expected) << "pieces " << pieces;
+    }
+}
+
+// check if the table agrees with placing every open cell and testing its lines
+TEST(ThreatsTest, TableMatchesPlacing) {
+    checkEveryPieceSet<Board3>();
+}
+
+// check if the table of the largest board that has one agrees with placing every open cell
+TEST(ThreatsTest, LargestTableMatchesPlacing) {
+    static_assert(Board<3, 4, 3>::CELLS == THREAT_TABLE_CELLS, "3x4 is the largest board with a table");
+    checkEveryPieceSet<Board<3, 4, 3>>();
+}
+
+// check if the line scan of the smallest board without a table agrees with placing every open cell
+TEST(ThreatsTest, FirstBoardWithoutTable) {
+    static_assert(Board<4, 4, 4>::CELLS > THREAT_TABLE_CELLS, "4x4 is scanned line by line");
+    checkEveryPieceSet<Board<4, 4, 4>>();
+}
+
+// check if the winning and blocking moves of a position are found
+TEST(ThreatsTest, WinAndBlock) {
+    // arrange
+    Board3 board;
+    board.place(0, X);
+    board.place(3, O);
+    board.place(1, X);
+    board.place(4, O);
+
+    // action
+    Board3::Mask wins = Threats<Board3>::winningMoves(board, X);
+    Board3::Mask blocks = Threats<Board3>::blockingMoves(board, X);
+
+    // assert
+    EXPECT_EQ(wins, Board3::bit(2));
+    EXPECT_EQ(blocks, Board3::bit(5));
+}
+
+// check if a cell taken by the opponent is not a threat
+TEST(ThreatsTest, TakenCellIsNoThreat) {
+    // arrange
+    Board3 board;
+    board.place(0, X);
+    board.place(2, O);
+    board.place(1, X);
+
+    // action
+    Board3::Mask wins = Threats<Board3>::winningMoves(board, X);
+
+    // assert
+    EXPECT_EQ(wins, 0u);
+}
+
+// check if the line scan of a large board finds the cell of a four in a row
+TEST(ThreatsTest, LargeBoardThreat) {
+    // arrange
+    Board7 board;
+    board.place(1, X);
+    board.place(7, O);
+    board.place(2, X);
+    board.place(8, O);
+    board.place(3, X);
+    board.place(9, O);
+    board.place(4, X);
+
+    // action
+    Board7::Mask wins = Threats<Board7>::winningMoves(board, X);
+    Board7::Mask blocks = Threats<Board7>::blockingMoves(board, O);
+
+    // assert
+    EXPECT_EQ(wins, Board7::bit(0) | Board7::bit(5));
+    EXPECT_EQ(blocks, wins);
+}
+
+// check if the open lines of every number of pieces are counted
+TEST(ThreatsTest, CountOpenLines) {
+    // arrange
+    Board3 board;
+    board.place(4, X);
+    board.place(0, O);
+
+    // action
+    int xOnes = Threats<Board3>::countOpenLines(board, X, 1);
+    int oOnes = Threats<Board3>::countOpenLines(board, O, 1);
+    int empty = Threats<Board3>::countOpenLines(board, X, 0);
+
+    // assert
+    EXPECT_EQ(xOnes, 3);
+    EXPECT_EQ(oOnes, 2);
+    EXPECT_EQ(empty, 2);
+}
+
+// check if a cell that makes two threats at once is a fork
+TEST(ThreatsTest, ForkMoves) {
+    // arrange
+    Board3 board;
+    board.place(0, X);
+    board.place(4, O);
+    board.place(8, X);
+    board.place(1, O);
+
+    // action
+    Board3::Mask forks = Threats<Board3>::forkMoves(board, X);
+
+    // assert
+    EXPECT_TRUE(forks & Board3::bit(6));
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "TranspositionTable.h"
+#include "PlayerType.h"
+#include "Model.h"
+
+// check if a stored entry is found with the same content
+TEST(TranspositionTableTest, StoreAndProbe) {
+    // arrange
+    TranspositionTable table(1);
+    TTEntry entry;
+
+    // action
+    bool stored = table.store(12345, -7, 4, LowerBound, 3);
+
+    // assert
+    EXPECT_TRUE(stored);
+    ASSERT_TRUE(table.probe(12345, entry));
+    EXPECT_EQ(entry.score, -7);
+    EXPECT_EQ(entry.depth, 4);
+    EXPECT_EQ(entry.bound, LowerBound);
+    EXPECT_EQ(entry.bestMove, 3);
+    EXPECT_FALSE(table.probe(54321, entry));
+}
+
+// check if the table size follows the memory budget
+TEST(TranspositionTableTest, SizeFromMemory) {
+    // arrange
+    TranspositionTable table(1);
+
+    // assert
+    EXPECT_EQ(table.size(), 65536u);
+
+    // action
+    table.resize(2);
+
+    // assert
+    EXPECT_EQ(table.size(), 131072u);
+}
+
+// check if a deeper entry of the same search isn't replaced by a shallower one
+TEST(TranspositionTableTest, DepthPreferredReplacement) {
+    // arrange
+    TranspositionTable table(0);
+    TTEntry entry;
+    table.store(1, 5, 8, Exact, 0);
+
+    // action
+    bool replaced = table.store(2, 3, 2, Exact, 1);
+
+    // assert
+    EXPECT_FALSE(replaced);
+    EXPECT_TRUE(table.probe(1, entry));
+    EXPECT_FALSE(table.probe(2, entry));
+
+    // action
+    table.newSearch();
+    table.store(2, 3, 2, Exact, 1);
+
+    // assert
+    EXPECT_TRUE(table.probe(2, entry));
+}
+
+// check if the Hard AI search fills the table and still finds the win
+TEST(TranspositionTableTest, HardSearchUsesTable) {
+    // arrange
+    Model game;
+    AI ai(Hard);
+    ai.setUseSolvedTable(false);
+
+    game.play(0, 0);
+    game.play(1, 1);
+    game.play(2, 2);
+    game.play(2, 0);
+    game.play(2, 1);
+
+    // action
+    ai.play(O, game, -1, -1);
+
+    // assert
+    EXPECT_EQ(game.getWinner(), O);
+    EXPECT_GT(ai.getLastStats().tableStores, 0u);
+}